@@ -1,5 +1,7 @@
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "vortexalloc/allocator.hpp"
+#include "vortexalloc/object_pool.hpp"
+#include "vortexalloc/segmented_vector.hpp"
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <list>
@@ -9,6 +11,8 @@
 #include <unordered_set>
 #include <random>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 
 constexpr std::size_t N = 1000000;
@@ -399,15 +403,16 @@ TEST_CASE("Arena Allocator Strengths - Tree Structure Performance") {
     };
 
     BENCHMARK("ChunkAllocator - binary tree construction") {
-        std::vector<std::unique_ptr<struct TreeNode>> nodes;
+        ChunkAllocator<TreeNode> alloc;
+        std::vector<TreeNode*> nodes;
         nodes.reserve(SMALL_N);
         
         for (std::size_t i = 0; i < SMALL_N; ++i) {
-            auto node = std::make_unique<struct TreeNode>();
+            TreeNode* node = alloc.allocate(1);
             node->value = i;
             node->left = nullptr;
             node->right = nullptr;
-            nodes.push_back(std::move(node));
+            nodes.push_back(node);
         }
         return nodes.size();
     };
@@ -507,4 +512,294 @@ TEST_CASE("Arena Allocator Strengths - Zero-Copy Operations") {
         }
         return lists.size();
     };
-}
\ No newline at end of file
+}
+
+TEST_CASE("Object Pool - Tree Node Allocate, Free and Sweep") {
+    // allocate SMALL_N nodes, free every other one, refill the holes and
+    // sweep over everything that is still alive
+    BENCHMARK("new/delete - tree node lifecycle") {
+        std::vector<TreeNode*> nodes;
+        nodes.reserve(SMALL_N + SMALL_N / 2);
+        for (std::size_t i = 0; i < SMALL_N; ++i) {
+            nodes.push_back(new TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+        for (std::size_t i = 0; i < SMALL_N; i += 2) {
+            delete nodes[i];
+            nodes[i] = nullptr;
+        }
+        for (std::size_t i = 0; i < SMALL_N / 2; ++i) {
+            nodes.push_back(new TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+
+        long long sum = 0;
+        for (TreeNode* node : nodes) {
+            if (node) {
+                sum += node->value;
+            }
+        }
+        for (TreeNode* node : nodes) {
+            delete node;
+        }
+        return sum;
+    };
+
+    BENCHMARK("std::list<TreeNode> - tree node lifecycle") {
+        std::list<TreeNode> nodes;
+        for (std::size_t i = 0; i < SMALL_N; ++i) {
+            nodes.push_back(TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+        bool erase = true;
+        for (auto it = nodes.begin(); it != nodes.end(); erase = !erase) {
+            it = erase ? nodes.erase(it) : std::next(it);
+        }
+        for (std::size_t i = 0; i < SMALL_N / 2; ++i) {
+            nodes.push_back(TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+
+        long long sum = 0;
+        for (const TreeNode& node : nodes) {
+            sum += node.value;
+        }
+        return sum;
+    };
+
+    BENCHMARK("ChunkAllocator<TreeNode> - tree node lifecycle") {
+        std::list<TreeNode, ChunkAllocator<TreeNode>> nodes;
+        for (std::size_t i = 0; i < SMALL_N; ++i) {
+            nodes.push_back(TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+        bool erase = true;
+        for (auto it = nodes.begin(); it != nodes.end(); erase = !erase) {
+            it = erase ? nodes.erase(it) : std::next(it);
+        }
+        for (std::size_t i = 0; i < SMALL_N / 2; ++i) {
+            nodes.push_back(TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+
+        long long sum = 0;
+        for (const TreeNode& node : nodes) {
+            sum += node.value;
+        }
+        return sum;
+    };
+
+    BENCHMARK("ObjectPool<TreeNode> - tree node lifecycle") {
+        ObjectPool<TreeNode> pool;
+        std::vector<TreeNode*> nodes;
+        nodes.reserve(SMALL_N);
+        for (std::size_t i = 0; i < SMALL_N; ++i) {
+            nodes.push_back(pool.create(TreeNode{static_cast<int>(i), nullptr, nullptr}));
+        }
+        for (std::size_t i = 0; i < SMALL_N; i += 2) {
+            pool.destroy(nodes[i]);
+        }
+        for (std::size_t i = 0; i < SMALL_N / 2; ++i) {
+            (void)pool.create(TreeNode{static_cast<int>(i), nullptr, nullptr});
+        }
+
+        long long sum = 0;
+        pool.for_each_live([&](const TreeNode& node) { sum += node.value; });
+        return sum;
+    };
+}
+
+
+TEST_CASE("Policy-Based Arena Specialization") {
+    using FixedArena = BasicArena<FixedGrowth>;
+    using LockedArena = BasicArena<DoublingGrowth<>, NewBacking, MutexLocked>;
+
+    // sizes only known at run time, as at a type-erased call site
+    volatile std::size_t runtime_size = sizeof(TreeNode);
+    volatile std::size_t runtime_align = alignof(TreeNode);
+
+    BENCHMARK("Arena - runtime size and alignment") {
+        Arena arena(1024 * 1024);
+        const std::size_t size = runtime_size;
+        const std::size_t align = runtime_align;
+        void* last = nullptr;
+        for (std::size_t i = 0; i < N; ++i) {
+            last = arena.allocate(size, align);
+        }
+        return last;
+    };
+
+    BENCHMARK("Arena - compile-time size and alignment") {
+        Arena arena(1024 * 1024);
+        void* last = nullptr;
+        for (std::size_t i = 0; i < N; ++i) {
+            last = arena.allocate<sizeof(TreeNode), alignof(TreeNode)>();
+        }
+        return last;
+    };
+
+    BENCHMARK("BasicArena<FixedGrowth> - compile-time size and alignment") {
+        FixedArena arena(1024 * 1024);
+        void* last = nullptr;
+        for (std::size_t i = 0; i < N; ++i) {
+            last = arena.allocate<sizeof(TreeNode), alignof(TreeNode)>();
+        }
+        return last;
+    };
+
+    BENCHMARK("BasicArena<MutexLocked> - compile-time size and alignment") {
+        LockedArena arena(1024 * 1024);
+        void* last = nullptr;
+        for (std::size_t i = 0; i < N; ++i) {
+            last = arena.allocate<sizeof(TreeNode), alignof(TreeNode)>();
+        }
+        return last;
+    };
+}
+
+
+TEST_CASE("Segmented Vector - Growth and Sequential Scan") {
+    // growth without reserve, the vector cases reallocate and copy
+    BENCHMARK("std::vector<int> - push_back without reserve") {
+        std::vector<int> v;
+        for (std::size_t i = 0; i < N; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        return v.size();
+    };
+
+    BENCHMARK("ChunkAllocator<int> - push_back without reserve") {
+        std::vector<int, ChunkAllocator<int>> v;
+        for (std::size_t i = 0; i < N; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        return v.size();
+    };
+
+    BENCHMARK("SegmentedVector<int> - push_back without reserve") {
+        SegmentedVector<int> v;
+        for (std::size_t i = 0; i < N; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        return v.size();
+    };
+
+    std::vector<int, ChunkAllocator<int>> chunk_vector;
+    SegmentedVector<int> segmented;
+    for (std::size_t i = 0; i < N; ++i) {
+        chunk_vector.push_back(static_cast<int>(i));
+        segmented.push_back(static_cast<int>(i));
+    }
+
+    BENCHMARK("ChunkAllocator<int> - sequential scan") {
+        long long sum = 0;
+        for (int value : chunk_vector) {
+            sum += value;
+        }
+        return sum;
+    };
+
+    BENCHMARK("SegmentedVector<int> - indexed scan") {
+        long long sum = 0;
+        for (std::size_t i = 0; i < segmented.size(); ++i) {
+            sum += segmented[i];
+        }
+        return sum;
+    };
+
+    BENCHMARK("SegmentedVector<int> - segment-wise scan") {
+        long long sum = 0;
+        segmented.for_each_segment([&sum](const int* data, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += data[i];
+            }
+        });
+        return sum;
+    };
+}
+
+
+TEST_CASE("Zeroed Allocation - Large Hash Tables") {
+    using MmapArena = BasicArena<DoublingGrowth<>, MmapBacking<>>;
+
+    // a round builds eight 512KB zeroed tables and touches a few slots in
+    // each, like a sparse hash table or bitmap, then the arena is reset.
+    // Pages that are never touched are never faulted in, which is where
+    // the zeroed backings win; dense tables pay a page fault per page.
+    constexpr std::size_t kTables = 8;
+    constexpr std::size_t kTableBytes = 512 * 1024;
+    constexpr std::size_t kArenaBytes = kTables * kTableBytes;
+    constexpr std::size_t kRounds = 16;
+
+    const auto touch = [](void* table) {
+        auto* slots = static_cast<std::uint64_t*>(table);
+        std::uint64_t sum = 0;
+        constexpr std::size_t kSlots = kTableBytes / sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < kSlots; i += kSlots / 16 + 7) {
+            sum += slots[i]++;
+        }
+        return sum;
+    };
+
+    Arena memset_arena(kArenaBytes);
+    BENCHMARK("Arena - allocate + memset, reset between rounds") {
+        std::uint64_t sum = 0;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            for (std::size_t t = 0; t < kTables; ++t) {
+                void* table = memset_arena.allocate(kTableBytes, 64);
+                std::memset(table, 0, kTableBytes);
+                sum += touch(table);
+            }
+            memset_arena.reset();
+        }
+        return sum;
+    };
+
+    MmapArena retain_arena(kArenaBytes);
+    BENCHMARK("MmapBacking - allocate_zeroed, reset between rounds") {
+        std::uint64_t sum = 0;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            for (std::size_t t = 0; t < kTables; ++t) {
+                sum += touch(retain_arena.allocate_zeroed(kTableBytes, 64));
+            }
+            retain_arena.reset();
+        }
+        return sum;
+    };
+
+    MmapArena decommit_arena(kArenaBytes);
+    BENCHMARK("MmapBacking - allocate_zeroed, decommit between rounds") {
+        std::uint64_t sum = 0;
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            for (std::size_t t = 0; t < kTables; ++t) {
+                sum += touch(decommit_arena.allocate_zeroed(kTableBytes, 64));
+            }
+            decommit_arena.reset(ResetMode::Decommit);
+        }
+        return sum;
+    };
+
+    // fresh arenas, where zeroed backings never have to clear anything
+    BENCHMARK("Arena - fresh arena, allocate + memset") {
+        Arena arena(kArenaBytes);
+        std::uint64_t sum = 0;
+        for (std::size_t t = 0; t < kTables; ++t) {
+            void* table = arena.allocate(kTableBytes, 64);
+            std::memset(table, 0, kTableBytes);
+            sum += touch(table);
+        }
+        return sum;
+    };
+
+    BENCHMARK("MmapBacking - fresh arena, allocate_zeroed") {
+        MmapArena arena(kArenaBytes);
+        std::uint64_t sum = 0;
+        for (std::size_t t = 0; t < kTables; ++t) {
+            sum += touch(arena.allocate_zeroed(kTableBytes, 64));
+        }
+        return sum;
+    };
+
+    BENCHMARK("CallocBacking - fresh arena, allocate_zeroed") {
+        BasicArena<DoublingGrowth<>, CallocBacking> arena(kArenaBytes);
+        std::uint64_t sum = 0;
+        for (std::size_t t = 0; t < kTables; ++t) {
+            sum += touch(arena.allocate_zeroed(kTableBytes, 64));
+        }
+        return sum;
+    };
+}
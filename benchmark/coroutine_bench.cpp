@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "vortexalloc/coroutine.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace {
+
+constexpr int CHAIN_DEPTH = 1000;
+constexpr int CHAIN_RUNS = 100;
+
+struct HeapFrames {};
+
+template <typename FramePolicy>
+class Task {
+public:
+    struct promise_type : FramePolicy {
+        int value = 0;
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        Task get_return_object() {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                return h.promise().continuation;
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(int v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+        handle_.promise().continuation = c;
+        return handle_;
+    }
+    int await_resume() noexcept { return handle_.promise().value; }
+
+    int run() {
+        handle_.resume();
+        return handle_.promise().value;
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Both chains take the same parameters so their frames have the same shape,
+// only the promise decides where the frame lives.
+Task<HeapFrames> heap_chain(FrameArena& frames, int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await heap_chain(frames, depth - 1);
+}
+
+Task<ArenaFramePromise> arena_chain(FrameArena& frames, int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await arena_chain(frames, depth - 1);
+}
+
+} // namespace
+
+TEST_CASE("Coroutine Frame Allocation - Deep Await Chain") {
+    BENCHMARK("operator new - awaiting coroutine chain") {
+        FrameArena frames;
+        long long total = 0;
+        for (int run = 0; run < CHAIN_RUNS; ++run) {
+            total += heap_chain(frames, CHAIN_DEPTH).run();
+        }
+        return total;
+    };
+
+    BENCHMARK("FrameArena - awaiting coroutine chain") {
+        FrameArena frames;
+        long long total = 0;
+        for (int run = 0; run < CHAIN_RUNS; ++run) {
+            total += arena_chain(frames, CHAIN_DEPTH).run();
+        }
+        return total;
+    };
+
+    BENCHMARK("FrameArena with reset - awaiting coroutine chain") {
+        FrameArena frames(64 * 1024);
+        long long total = 0;
+        for (int run = 0; run < CHAIN_RUNS; ++run) {
+            total += arena_chain(frames, CHAIN_DEPTH).run();
+            frames.reset();
+        }
+        return total;
+    };
+}
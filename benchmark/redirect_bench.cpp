@@ -0,0 +1,74 @@
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "vortexalloc/redirect.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+// Run with LD_PRELOAD=libvortexalloc_preload.so. The "no guard" cases then
+// measure glibc reached through the shim's malloc and free, the cost every
+// unguarded allocation pays once the shim is loaded. For plain glibc numbers
+// run the binary a second time without LD_PRELOAD, the guarded cases then
+// measure glibc as well.
+
+constexpr std::size_t N = 100000;
+
+namespace {
+// Stand-in for third-party code that knows nothing about arenas
+std::size_t library_workload() {
+    std::map<int, std::string> table;
+    for (std::size_t i = 0; i < N; ++i) {
+        table.emplace(static_cast<int>(i), "value_" + std::to_string(i));
+    }
+    std::size_t total = 0;
+    for (const auto& [key, value] : table) {
+        total += value.size();
+    }
+    return total;
+}
+
+std::size_t malloc_workload() {
+    std::vector<void*> blocks(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        blocks[i] = std::malloc(16 + i % 256);
+    }
+    for (void* p : blocks) {
+        std::free(p);
+    }
+    return blocks.size();
+}
+} // namespace
+
+TEST_CASE("Allocation Redirection - Library Workload") {
+    if (!ScopedArenaRedirect::available()) {
+        WARN("redirection shim is not loaded, nothing is redirected");
+    }
+    // one long-lived arena per thread, reset per request
+    Arena arena(1024 * 1024);
+
+    BENCHMARK("no guard - std::map<int, std::string> workload") {
+        return library_workload();
+    };
+
+    BENCHMARK("ScopedArenaRedirect - std::map<int, std::string> workload") {
+        arena.reset();
+        ScopedArenaRedirect redirect(arena);
+        return library_workload();
+    };
+}
+
+TEST_CASE("Allocation Redirection - malloc/free") {
+    Arena arena(1024 * 1024);
+
+    BENCHMARK("no guard - malloc/free mixed sizes") {
+        return malloc_workload();
+    };
+
+    BENCHMARK("ScopedArenaRedirect - malloc/free mixed sizes") {
+        arena.reset();
+        ScopedArenaRedirect redirect(arena);
+        return malloc_workload();
+    };
+}
@@ -0,0 +1,772 @@
+// Regression benchmark suite.
+//
+// Runs every workload with every allocator across a set of thread counts and
+// reports throughput, sampled per-allocation latency, peak RSS, page faults,
+// the bytes an allocator holds at the peak and how many of them are lost to
+// padding and dead buffers. Each
+// measurement runs in a forked child so RSS and fault counts are its own.
+//
+//   bench_suite [--threads 1,2,4] [--ops N] [--repeat K] [--filter TEXT]
+//               [--json FILE] [--baseline FILE] [--tolerance 0.10]
+//               [--no-fork]
+//
+// With --baseline the results are compared against a JSON file written by a
+// previous --json run and the exit status is 1 if anything regressed by more
+// than the tolerance.
+
+#include "vortexalloc/allocator.hpp"
+#include "vortexalloc/segmented_vector.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <malloc.h>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using CountingArena =
+    BasicArena<DoublingGrowth<>, NewBacking, SingleThreaded, CountingStats>;
+using LockedCountingArena =
+    BasicArena<DoublingGrowth<>, NewBacking, MutexLocked, CountingStats>;
+
+using Clock = std::chrono::steady_clock;
+
+// one in kSampleEvery allocations is timed
+constexpr std::size_t kSampleEvery = 8;
+
+// ---------------------------------------------------------------- results
+
+struct Result {
+    char workload[48] = {};
+    char allocator[48] = {};
+    std::size_t threads = 0;
+    std::size_t operations = 0;
+    std::size_t allocations = 0;
+    double seconds = 0;
+    double ops_per_sec = 0;
+    double p50_ns = 0;
+    double p99_ns = 0;
+    long peak_rss_kb = 0;
+    long page_faults = 0;
+    std::size_t requested_bytes = 0;
+    std::size_t footprint_bytes = 0;
+    std::size_t padding_bytes = 0;
+    std::size_t dead_bytes = 0;
+};
+
+// Memory an allocator holds at the peak of a workload
+struct MemoryReport {
+    // heap growth for malloc, used arena bytes for the arenas
+    std::size_t footprint = 0;
+    std::size_t padding = 0;
+    std::size_t dead = 0;
+};
+
+// ------------------------------------------------------- timed allocator
+
+struct ThreadProbe {
+    std::vector<std::uint32_t> samples;
+    std::size_t allocations = 0;
+    std::size_t requested = 0;
+    std::size_t live = 0;
+};
+
+// Wraps an allocator to count requests and sample allocation latency
+template <typename T, typename Inner>
+struct TimedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = TimedAllocator<
+            U, typename std::allocator_traits<Inner>::template rebind_alloc<U>>;
+    };
+
+    Inner inner;
+    ThreadProbe* probe;
+
+    TimedAllocator(Inner inner, ThreadProbe* probe) : inner(std::move(inner)), probe(probe) {}
+
+    template <typename U, typename I>
+    TimedAllocator(const TimedAllocator<U, I>& other) : inner(other.inner), probe(other.probe) {}
+
+    T* allocate(std::size_t n) {
+        const std::size_t bytes = n * sizeof(T);
+        probe->requested += bytes;
+        probe->live += bytes;
+        if (++probe->allocations % kSampleEvery != 0) {
+            return inner.allocate(n);
+        }
+
+        const auto start = Clock::now();
+        T* p = inner.allocate(n);
+        const auto elapsed = Clock::now() - start;
+        probe->samples.push_back(static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        probe->live -= n * sizeof(T);
+        inner.deallocate(p, n);
+    }
+
+    template <typename U, typename I>
+    friend bool operator==(const TimedAllocator& a, const TimedAllocator<U, I>& b) noexcept {
+        return a.probe == b.probe;
+    }
+
+    template <typename U, typename I>
+    friend bool operator!=(const TimedAllocator& a, const TimedAllocator<U, I>& b) noexcept {
+        return a.probe != b.probe;
+    }
+};
+
+// ------------------------------------------------------------ allocators
+
+std::size_t heap_in_use() {
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+// used bytes of an arena, padding is what was not asked for
+template <typename ArenaT>
+MemoryReport arena_report(const ArenaT& arena) {
+    std::size_t used = 0;
+    for (const Chunk* c = arena.head_; c; c = c->next) {
+        used += c->offset;
+    }
+    const CountingStats& stats = arena.stats();
+    return {used, used - stats.bytes_requested, stats.bytes_released};
+}
+
+struct StdKind {
+    static constexpr const char* name = "std::allocator";
+    using allocator = std::allocator<std::byte>;
+
+    struct Shared {
+        std::size_t heap_before = 0;
+    };
+
+    static allocator make(Shared&) { return {}; }
+
+    // after the threads and probes exist, so only the workload is measured
+    static void start(Shared& shared) { shared.heap_before = heap_in_use(); }
+
+    // malloc bookkeeping and rounding, freed blocks are reused so none are dead
+    static MemoryReport report(Shared& shared, const std::vector<allocator>&,
+                               std::size_t live_bytes) {
+        const std::size_t now = heap_in_use();
+        const std::size_t heap = now > shared.heap_before ? now - shared.heap_before : 0;
+        return {heap, heap > live_bytes ? heap - live_bytes : 0, 0};
+    }
+};
+
+struct ArenaKind {
+    static constexpr const char* name = "ChunkAllocator";
+    using allocator = ChunkAllocator<std::byte, CountingArena>;
+
+    struct Shared {};
+
+    // one arena per thread
+    static allocator make(Shared&) { return allocator(64 * 1024); }
+
+    static void start(Shared&) {}
+
+    static MemoryReport report(Shared&, const std::vector<allocator>& allocators,
+                               std::size_t) {
+        MemoryReport total;
+        for (const allocator& alloc : allocators) {
+            const MemoryReport r = arena_report(*alloc.arena());
+            total.footprint += r.footprint;
+            total.padding += r.padding;
+            total.dead += r.dead;
+        }
+        return total;
+    }
+};
+
+struct LockedArenaKind {
+    static constexpr const char* name = "ChunkAllocator<MutexLocked>";
+    using allocator = ChunkAllocator<std::byte, LockedCountingArena>;
+
+    // one arena shared by every thread
+    struct Shared {
+        allocator alloc{64 * 1024};
+    };
+
+    static allocator make(Shared& shared) { return shared.alloc; }
+
+    static void start(Shared&) {}
+
+    static MemoryReport report(Shared& shared, const std::vector<allocator>&,
+                               std::size_t) {
+        return arena_report(*shared.alloc.arena());
+    }
+};
+
+// ------------------------------------------------------------- workloads
+//
+// Each workload builds its data structures, calls peak() while everything is
+// still alive and then tears them down. It returns the number of operations.
+// Everything a workload allocates goes through alloc, bookkeeping included,
+// so every allocator is charged for the same memory.
+
+struct ListPush {
+    static constexpr const char* name = "list_push";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using IntAlloc = typename std::allocator_traits<A>::template rebind_alloc<int>;
+        std::list<int, IntAlloc> l{IntAlloc(alloc)};
+        for (std::size_t i = 0; i < ops; ++i) {
+            l.push_back(static_cast<int>(i));
+        }
+        peak();
+        return ops;
+    }
+};
+
+// growth without reserve, every reallocation leaves a dead buffer behind
+struct VectorGrowth {
+    static constexpr const char* name = "vector_growth";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using IntAlloc = typename std::allocator_traits<A>::template rebind_alloc<int>;
+        using Vec = std::vector<int, IntAlloc>;
+        using VecAlloc = typename std::allocator_traits<A>::template rebind_alloc<Vec>;
+
+        const std::size_t per_vector = 1000;
+        std::vector<Vec, VecAlloc> vectors{VecAlloc(alloc)};
+        vectors.reserve(ops / per_vector + 1);
+        for (std::size_t done = 0; done < ops; done += per_vector) {
+            Vec& v = vectors.emplace_back(IntAlloc(alloc));
+            for (std::size_t i = 0; i < per_vector; ++i) {
+                v.push_back(static_cast<int>(i));
+            }
+        }
+        peak();
+        return vectors.size() * per_vector;
+    }
+};
+
+// the same growth as vector_growth with segments that never move. Nothing
+// is dead, but 1000 elements need segments of 64 up to 1024 elements, so the
+// footprint column, not dead bytes, is the fair comparison
+struct SegmentedGrowth {
+    static constexpr const char* name = "segmented_growth";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using IntAlloc = typename std::allocator_traits<A>::template rebind_alloc<int>;
+        using Vec = SegmentedVector<int, IntAlloc>;
+        using VecAlloc = typename std::allocator_traits<A>::template rebind_alloc<Vec>;
+
+        const std::size_t per_vector = 1000;
+        std::vector<Vec, VecAlloc> vectors{VecAlloc(alloc)};
+        vectors.reserve(ops / per_vector + 1);
+        for (std::size_t done = 0; done < ops; done += per_vector) {
+            Vec& v = vectors.emplace_back(IntAlloc(alloc));
+            for (std::size_t i = 0; i < per_vector; ++i) {
+                v.push_back(static_cast<int>(i));
+            }
+        }
+        peak();
+        return vectors.size() * per_vector;
+    }
+};
+
+struct DequeChurn {
+    static constexpr const char* name = "deque_churn";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using IntAlloc = typename std::allocator_traits<A>::template rebind_alloc<int>;
+        std::deque<int, IntAlloc> dq{IntAlloc(alloc)};
+        for (std::size_t i = 0; i < ops / 2; ++i) {
+            dq.push_back(static_cast<int>(i));
+            dq.push_front(static_cast<int>(i));
+        }
+        peak();
+        return ops / 2 * 2;
+    }
+};
+
+struct TreeNode {
+    int value;
+    TreeNode* left;
+    TreeNode* right;
+};
+
+// allocate nodes, free every other one and refill the holes
+struct TreeChurn {
+    static constexpr const char* name = "tree_churn";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using NodeAlloc = typename std::allocator_traits<A>::template rebind_alloc<TreeNode>;
+        using PointerAlloc = typename std::allocator_traits<A>::template rebind_alloc<TreeNode*>;
+        NodeAlloc nodes_alloc(alloc);
+
+        const std::size_t n = ops * 2 / 3;
+        std::vector<TreeNode*, PointerAlloc> nodes(n, nullptr, PointerAlloc(alloc));
+        for (std::size_t i = 0; i < n; ++i) {
+            nodes[i] = nodes_alloc.allocate(1);
+            *nodes[i] = TreeNode{static_cast<int>(i), nullptr, nullptr};
+        }
+        for (std::size_t i = 0; i < n; i += 2) {
+            nodes_alloc.deallocate(nodes[i], 1);
+            nodes[i] = nodes_alloc.allocate(1);
+            *nodes[i] = TreeNode{static_cast<int>(i), nullptr, nullptr};
+        }
+        peak();
+        for (TreeNode* node : nodes) {
+            nodes_alloc.deallocate(node, 1);
+        }
+        return n + (n + 1) / 2;
+    }
+};
+
+struct Strings {
+    static constexpr const char* name = "strings";
+
+    template <typename A>
+    static std::size_t run(const A& alloc, std::size_t ops, const std::function<void()>& peak) {
+        using CharAlloc = typename std::allocator_traits<A>::template rebind_alloc<char>;
+        using String = std::basic_string<char, std::char_traits<char>, CharAlloc>;
+        using StringAlloc = typename std::allocator_traits<A>::template rebind_alloc<String>;
+
+        std::vector<String, StringAlloc> strings{StringAlloc(alloc)};
+        strings.reserve(ops);
+        for (std::size_t i = 0; i < ops; ++i) {
+            String s("a string that is too long for SSO #", CharAlloc(alloc));
+            s += std::to_string(i).c_str();
+            strings.push_back(std::move(s));
+        }
+        peak();
+        return ops;
+    }
+};
+
+// ----------------------------------------------------------- measurement
+
+template <typename Workload, typename Kind>
+Result measure(std::size_t threads, std::size_t ops) {
+    using Timed = TimedAllocator<std::byte, typename Kind::allocator>;
+
+    typename Kind::Shared shared;
+    std::vector<typename Kind::allocator> allocators;
+    std::vector<ThreadProbe> probes(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        allocators.push_back(Kind::make(shared));
+        probes[t].samples.reserve(ops / kSampleEvery + 64);
+    }
+
+    Result result;
+    std::snprintf(result.workload, sizeof(result.workload), "%s", Workload::name);
+    std::snprintf(result.allocator, sizeof(result.allocator), "%s", Kind::name);
+    result.threads = threads;
+
+    std::vector<std::size_t> operations(threads);
+    Clock::time_point start;
+    Clock::time_point stop;
+
+    // all threads start together and pause together at their peak
+    std::barrier start_line(static_cast<std::ptrdiff_t>(threads), [&]() noexcept {
+        Kind::start(shared);
+        start = Clock::now();
+    });
+    std::barrier peak_line(static_cast<std::ptrdiff_t>(threads), [&]() noexcept {
+        stop = Clock::now();
+        std::size_t live = 0;
+        for (const ThreadProbe& probe : probes) {
+            live += probe.live;
+        }
+        const MemoryReport memory = Kind::report(shared, allocators, live);
+        result.footprint_bytes = memory.footprint;
+        result.padding_bytes = memory.padding;
+        result.dead_bytes = memory.dead;
+    });
+
+    const auto body = [&](std::size_t t) {
+        const Timed alloc(allocators[t], &probes[t]);
+        start_line.arrive_and_wait();
+        operations[t] = Workload::run(alloc, ops, [&] { peak_line.arrive_and_wait(); });
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(body, t);
+    }
+    body(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<std::uint32_t> samples;
+    for (const ThreadProbe& probe : probes) {
+        result.allocations += probe.allocations;
+        result.requested_bytes += probe.requested;
+        samples.insert(samples.end(), probe.samples.begin(), probe.samples.end());
+    }
+    for (std::size_t n : operations) {
+        result.operations += n;
+    }
+
+    result.seconds = std::chrono::duration<double>(stop - start).count();
+    result.ops_per_sec = result.operations / std::max(result.seconds, 1e-9);
+
+    const auto percentile = [&samples](double q) -> double {
+        if (samples.empty()) {
+            return 0;
+        }
+        const auto nth = samples.begin() + static_cast<std::ptrdiff_t>(q * (samples.size() - 1));
+        std::nth_element(samples.begin(), nth, samples.end());
+        return *nth;
+    };
+    result.p50_ns = percentile(0.50);
+    result.p99_ns = percentile(0.99);
+    return result;
+}
+
+struct Case {
+    std::string workload;
+    std::string allocator;
+    std::function<Result(std::size_t, std::size_t)> run;
+};
+
+template <typename Workload, typename... Kinds>
+void add_cases(std::vector<Case>& cases) {
+    (cases.push_back({Workload::name, Kinds::name, &measure<Workload, Kinds>}), ...);
+}
+
+std::vector<Case> all_cases() {
+    std::vector<Case> cases;
+    add_cases<ListPush, StdKind, ArenaKind, LockedArenaKind>(cases);
+    add_cases<VectorGrowth, StdKind, ArenaKind, LockedArenaKind>(cases);
+    add_cases<SegmentedGrowth, StdKind, ArenaKind, LockedArenaKind>(cases);
+    add_cases<DequeChurn, StdKind, ArenaKind, LockedArenaKind>(cases);
+    add_cases<TreeChurn, StdKind, ArenaKind, LockedArenaKind>(cases);
+    add_cases<Strings, StdKind, ArenaKind, LockedArenaKind>(cases);
+    return cases;
+}
+
+// runs one case with its own resource accounting
+Result run_isolated(const Case& c, std::size_t threads, std::size_t ops, bool use_fork) {
+    const auto finish = [&](Result r) {
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        r.peak_rss_kb = usage.ru_maxrss;
+        r.page_faults = usage.ru_minflt + usage.ru_majflt;
+        return r;
+    };
+
+    if (!use_fork) {
+        struct rusage before {};
+        getrusage(RUSAGE_SELF, &before);
+        Result r = finish(c.run(threads, ops));
+        r.page_faults -= before.ru_minflt + before.ru_majflt;
+        return r;
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        std::perror("pipe");
+        std::exit(2);
+    }
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        const Result r = finish(c.run(threads, ops));
+        const ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    Result r;
+    const ssize_t got = read(fds[0], &r, sizeof(r));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (got != static_cast<ssize_t>(sizeof(r)) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::fprintf(stderr, "%s/%s with %zu threads failed\n", c.workload.c_str(),
+                     c.allocator.c_str(), threads);
+        std::exit(2);
+    }
+    return r;
+}
+
+// ------------------------------------------------------------------ json
+
+void write_json(std::ostream& out, const std::vector<Result>& results) {
+    out.precision(10);
+    out << "{\n  \"suite\": \"vortexalloc\",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"workload\": \"" << r.workload << "\", \"allocator\": \"" << r.allocator
+            << "\", \"threads\": " << r.threads << ", \"operations\": " << r.operations
+            << ", \"allocations\": " << r.allocations << ", \"seconds\": " << r.seconds
+            << ", \"ops_per_sec\": " << r.ops_per_sec << ", \"p50_ns\": " << r.p50_ns
+            << ", \"p99_ns\": " << r.p99_ns << ", \"peak_rss_kb\": " << r.peak_rss_kb
+            << ", \"page_faults\": " << r.page_faults
+            << ", \"requested_bytes\": " << r.requested_bytes
+            << ", \"footprint_bytes\": " << r.footprint_bytes
+            << ", \"padding_bytes\": " << r.padding_bytes
+            << ", \"dead_bytes\": " << r.dead_bytes << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+// Reads back what write_json produces: flat objects of strings and numbers.
+// Nesting is skipped over, only the innermost objects become records.
+using Record = std::map<std::string, std::string>;
+
+std::vector<Record> read_json_records(const std::string& text) {
+    std::vector<Record> records;
+    Record current;
+    std::string key;
+    bool in_object = false;
+    bool expect_value = false;
+
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char ch = text[i];
+        if (ch == '{') {
+            current.clear();
+            in_object = true;
+            expect_value = false;
+        } else if (ch == '}') {
+            if (in_object && !current.empty()) {
+                records.push_back(current);
+            }
+            in_object = false;
+        } else if (ch == ':') {
+            expect_value = true;
+        } else if (ch == '"') {
+            const std::size_t end = text.find('"', i + 1);
+            if (end == std::string::npos) {
+                break;
+            }
+            std::string token = text.substr(i + 1, end - i - 1);
+            i = end;
+            if (expect_value) {
+                current[key] = token;
+                expect_value = false;
+            } else {
+                key = token;
+            }
+        } else if (expect_value && (std::isdigit(static_cast<unsigned char>(ch)) || ch == '-')) {
+            std::size_t end = i;
+            while (end < text.size() && std::strchr("0123456789+-.eE", text[end])) {
+                ++end;
+            }
+            current[key] = text.substr(i, end - i);
+            i = end - 1;
+            expect_value = false;
+        }
+    }
+    return records;
+}
+
+struct Metric {
+    const char* name;
+    bool higher_is_better;
+    // differences below this are noise whatever the ratio
+    double floor;
+};
+
+constexpr Metric kCompared[] = {
+    {"ops_per_sec", true, 0},       {"p50_ns", false, 20},
+    {"p99_ns", false, 50},          {"peak_rss_kb", false, 1024},
+    {"page_faults", false, 64},     {"footprint_bytes", false, 4096},
+    {"padding_bytes", false, 4096}, {"dead_bytes", false, 4096},
+};
+
+double metric_of(const Result& r, const std::string& name) {
+    if (name == "ops_per_sec") return r.ops_per_sec;
+    if (name == "p50_ns") return r.p50_ns;
+    if (name == "p99_ns") return r.p99_ns;
+    if (name == "peak_rss_kb") return static_cast<double>(r.peak_rss_kb);
+    if (name == "page_faults") return static_cast<double>(r.page_faults);
+    if (name == "footprint_bytes") return static_cast<double>(r.footprint_bytes);
+    if (name == "padding_bytes") return static_cast<double>(r.padding_bytes);
+    if (name == "dead_bytes") return static_cast<double>(r.dead_bytes);
+    return 0;
+}
+
+// prints every metric that got worse than the tolerance allows
+std::size_t compare(const std::vector<Result>& results, const std::vector<Record>& baseline,
+                    double tolerance) {
+    std::size_t regressions = 0;
+    std::printf("\ncomparison against baseline (tolerance %.0f%%)\n", tolerance * 100);
+    for (const Result& r : results) {
+        const auto base = std::find_if(baseline.begin(), baseline.end(), [&](const Record& rec) {
+            return rec.count("workload") && rec.at("workload") == r.workload &&
+                   rec.count("allocator") && rec.at("allocator") == r.allocator &&
+                   rec.count("threads") && std::stoul(rec.at("threads")) == r.threads;
+        });
+        if (base == baseline.end()) {
+            std::printf("  %-17s %-28s %2zu threads: not in baseline\n", r.workload,
+                        r.allocator, r.threads);
+            continue;
+        }
+
+        for (const Metric& m : kCompared) {
+            if (!base->count(m.name)) {
+                continue;
+            }
+            const double old_value = std::stod(base->at(m.name));
+            const double new_value = metric_of(r, m.name);
+            const double worse_by = m.higher_is_better ? old_value - new_value : new_value - old_value;
+            if (worse_by <= m.floor || worse_by <= std::abs(old_value) * tolerance) {
+                continue;
+            }
+            ++regressions;
+            std::printf("  REGRESSION %-17s %-28s %2zu threads: %-13s %.6g -> %.6g\n", r.workload,
+                        r.allocator, r.threads, m.name, old_value, new_value);
+        }
+    }
+    std::printf("%zu regression(s)\n", regressions);
+    return regressions;
+}
+
+// ------------------------------------------------------------------- cli
+
+struct Options {
+    std::vector<std::size_t> threads{1, 2, 4};
+    std::size_t ops = 200000;
+    std::size_t repeat = 3;
+    std::string filter;
+    std::string json;
+    std::string baseline;
+    double tolerance = 0.10;
+    bool use_fork = true;
+};
+
+[[noreturn]] void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--threads 1,2,4] [--ops N] [--repeat K] [--filter TEXT]\n"
+                 "          [--json FILE] [--baseline FILE] [--tolerance 0.10] [--no-fork]\n",
+                 argv0);
+    std::exit(2);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--threads") {
+            opts.threads.clear();
+            std::stringstream list(value());
+            for (std::string item; std::getline(list, item, ',');) {
+                opts.threads.push_back(std::max<std::size_t>(std::stoul(item), 1));
+            }
+        } else if (arg == "--ops") {
+            opts.ops = std::stoul(value());
+        } else if (arg == "--repeat") {
+            opts.repeat = std::max<std::size_t>(std::stoul(value()), 1);
+        } else if (arg == "--filter") {
+            opts.filter = value();
+        } else if (arg == "--json") {
+            opts.json = value();
+        } else if (arg == "--baseline") {
+            opts.baseline = value();
+        } else if (arg == "--tolerance") {
+            opts.tolerance = std::stod(value());
+        } else if (arg == "--no-fork") {
+            opts.use_fork = false;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (opts.threads.empty()) {
+        usage(argv[0]);
+    }
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options opts = parse_options(argc, argv);
+
+    std::printf("%-17s %-28s %3s %12s %8s %8s %10s %8s %12s %12s %12s\n", "workload",
+                "allocator", "thr", "ops/s", "p50 ns", "p99 ns", "rss KB", "faults",
+                "footprint B", "padding B", "dead B");
+
+    std::vector<Result> results;
+    for (const Case& c : all_cases()) {
+        if (!opts.filter.empty() && (c.workload + "/" + c.allocator).find(opts.filter) == std::string::npos) {
+            continue;
+        }
+        for (std::size_t threads : opts.threads) {
+            // keep the repetition with the median throughput
+            std::vector<Result> runs;
+            for (std::size_t k = 0; k < opts.repeat; ++k) {
+                runs.push_back(run_isolated(c, threads, opts.ops, opts.use_fork));
+            }
+            std::sort(runs.begin(), runs.end(), [](const Result& a, const Result& b) {
+                return a.ops_per_sec < b.ops_per_sec;
+            });
+            const Result& r = runs[runs.size() / 2];
+
+            std::printf("%-17s %-28s %3zu %12.0f %8.0f %8.0f %10ld %8ld %12zu %12zu %12zu\n",
+                        r.workload, r.allocator, r.threads, r.ops_per_sec, r.p50_ns, r.p99_ns,
+                        r.peak_rss_kb, r.page_faults, r.footprint_bytes, r.padding_bytes,
+                        r.dead_bytes);
+            results.push_back(r);
+        }
+    }
+
+    if (!opts.json.empty()) {
+        std::ofstream out(opts.json);
+        write_json(out, results);
+        if (!out) {
+            std::fprintf(stderr, "could not write %s\n", opts.json.c_str());
+            return 2;
+        }
+    }
+
+    if (!opts.baseline.empty()) {
+        std::ifstream in(opts.baseline);
+        if (!in) {
+            std::fprintf(stderr, "could not read %s\n", opts.baseline.c_str());
+            return 2;
+        }
+        std::stringstream text;
+        text << in.rdbuf();
+        if (compare(results, read_json_records(text.str()), opts.tolerance) > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -12,10 +12,10 @@ inline std::aligned_storage_t<1, alignof(std::max_align_t)> dummy;
 inline void *non_null_one_byte() noexcept { return &dummy; }
 } // namespace detail
 
-template <typename T> class ChunkAllocator {
+template <typename T, typename ArenaT = Arena> class ChunkAllocator {
 private:
-  std::shared_ptr<Arena> arena_;
-  template <typename U> friend class ChunkAllocator;
+  std::shared_ptr<ArenaT> arena_;
+  template <typename U, typename A> friend class ChunkAllocator;
 
 public:
   using value_type = T;
@@ -24,28 +24,29 @@ public:
   using void_pointer = void *;
   using const_void_pointer = const void *;
   using size_type = std::size_t;
+  using arena_type = ArenaT;
   using difference_type = std::ptrdiff_t;
   using propagate_on_container_copy_assignment = std::true_type;
   using propagate_on_container_swap = std::true_type;
 
   template <class U> struct rebind {
-    using other = ChunkAllocator<U>;
+    using other = ChunkAllocator<U, ArenaT>;
   };
 
   using propagate_on_container_move_assignment = std::true_type;
   using is_always_equal = std::true_type;
 
   explicit ChunkAllocator(std::size_t chunk_size)
-      : arena_(std::make_shared<Arena>(chunk_size)) {}
+      : arena_(std::make_shared<ArenaT>(chunk_size)) {}
 
-  ChunkAllocator() : arena_(std::make_shared<Arena>()) {}
+  ChunkAllocator() : arena_(std::make_shared<ArenaT>()) {}
 
   // Copy constructor – makes a fresh allocator that shares no state
   ChunkAllocator(const ChunkAllocator &other) noexcept : arena_(other.arena_) {}
 
   // Converting copy constructor for rebinding
   template <class U>
-  explicit ChunkAllocator(const ChunkAllocator<U> &other) noexcept
+  explicit ChunkAllocator(const ChunkAllocator<U, ArenaT> &other) noexcept
       : arena_(other.arena_) {}
 
   ~ChunkAllocator() = default;
@@ -60,6 +61,12 @@ public:
       return static_cast<T *>(detail::non_null_one_byte());
     }
 
+    // single objects (node based containers) take the compile-time path
+    if (n == 1) {
+      return static_cast<T *>(
+          arena_->template allocate<sizeof(T), alignof(T)>());
+    }
+
     const std::size_t bytes = n * sizeof(T);
     const std::size_t align = alignof(T);
 
@@ -68,8 +75,10 @@ public:
     return static_cast<T *>(ptr);
   }
 
-  // chunk allocator does nothing
-  void deallocate(pointer p, std::size_t n) noexcept {}
+  // chunk allocator only reports the dead bytes to the arena stats
+  void deallocate(pointer p, std::size_t n) noexcept {
+    arena_->deallocate(p, n * sizeof(T));
+  }
 
   [[nodiscard]] size_type max_size() const noexcept {
     return std::numeric_limits<size_type>::max() / sizeof(T);
@@ -77,6 +86,10 @@ public:
 
   void reset() noexcept { arena_->reset(); }
 
+  [[nodiscard]] const std::shared_ptr<ArenaT> &arena() const noexcept {
+    return arena_;
+  }
+
   template <typename U, typename... Args> void construct(U *p, Args &&...args) {
     ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
   }
@@ -84,14 +97,14 @@ public:
   template <typename U> void destroy(U *p) { p->~U(); }
 
   template <typename U>
-  friend constexpr bool operator==(const ChunkAllocator<T> &,
-                                   const ChunkAllocator<U> &) noexcept {
+  friend constexpr bool operator==(const ChunkAllocator<T, ArenaT> &,
+                                   const ChunkAllocator<U, ArenaT> &) noexcept {
     return true;
   }
 
   template <typename U>
-  friend constexpr bool operator!=(const ChunkAllocator<T> &,
-                                   const ChunkAllocator<U> &) noexcept {
+  friend constexpr bool operator!=(const ChunkAllocator<T, ArenaT> &,
+                                   const ChunkAllocator<U, ArenaT> &) noexcept {
     return false;
   }
 };
\ No newline at end of file
@@ -1,74 +1,197 @@
 #pragma once
 
 #include "chunk.hpp"
+#include "policies.hpp"
+
+#include <mutex>
 #include <new>
 
-struct Arena {
+// Retain keeps every page of a reset arena resident, Decommit lets a backing
+// that supports it return the dirty pages to the OS
+enum class ResetMode { Retain, Decommit };
+
+template <typename GrowthPolicy = DoublingGrowth<>,
+          typename BackingPolicy = NewBacking,
+          typename ThreadPolicy = SingleThreaded,
+          typename StatsPolicy = NoStats>
+struct BasicArena {
+  using growth_policy = GrowthPolicy;
+  using backing_policy = BackingPolicy;
+  using thread_policy = ThreadPolicy;
+  using stats_policy = StatsPolicy;
+
   std::size_t initial_chunk_size_ = 8 * 1024; // Start with 8KB
-  std::size_t max_chunk_size_ = 1024 * 1024;  // Max 1MB
   Chunk *head_;
   Chunk *current_;
+  [[no_unique_address]] BackingPolicy backing_;
+  [[no_unique_address]] mutable ThreadPolicy lock_;
+  [[no_unique_address]] StatsPolicy stats_;
 
-  explicit Arena(const std::size_t initial_chunk_size)
+  explicit BasicArena(const std::size_t initial_chunk_size)
       : initial_chunk_size_(initial_chunk_size), head_(nullptr), current_(nullptr) {}
 
-  Arena() : head_(nullptr), current_(nullptr) {}
+  BasicArena() : head_(nullptr), current_(nullptr) {}
+
+  BasicArena(const BasicArena &) = delete;
+  BasicArena &operator=(const BasicArena &) = delete;
 
-  ~Arena() {
-    const Chunk *cur = head_;
+  ~BasicArena() {
+    Chunk *cur = head_;
     while (cur) {
-      const Chunk *next = cur->next;
+      Chunk *next = cur->next;
+      backing_.deallocate(cur->memory, cur->capacity);
       delete cur;
       cur = next;
     }
   }
 
   void *allocate(const std::size_t bytes, const std::size_t align) {
-    // if current is null allocate a new chunk
-    // set head and current to the new chunk
-    if (!current_) {
-      const std::size_t size = std::max(bytes, initial_chunk_size_);
-      current_ = new Chunk(size);
-      head_ = current_;
-    }
+    std::lock_guard<ThreadPolicy> guard(lock_);
 
     // try to allocate from the current chunk
-    void *ptr = current_->try_allocate(bytes, align);
+    void *ptr = current_ ? current_->try_allocate(bytes, align) : nullptr;
+    if (!ptr) {
+      ptr = allocate_slow(bytes, align, [bytes, align](Chunk *chunk) {
+        return chunk->try_allocate(bytes, align);
+      });
+    }
+
+    stats_.on_allocate(bytes);
+    return ptr;
+  }
 
-    // if the allocation failed, try to find space in existing chunks first
+  // Zero-initialized memory. Only memory that was handed out before (and
+  // not decommitted since) is cleared, fresh pages of a zeroed backing are
+  // returned as they are.
+  void *allocate_zeroed(const std::size_t bytes, const std::size_t align) {
+    std::lock_guard<ThreadPolicy> guard(lock_);
+
+    const auto try_zeroed = [bytes, align](Chunk *chunk) {
+      return chunk->try_allocate_zeroed(bytes, align);
+    };
+    void *ptr = current_ ? try_zeroed(current_) : nullptr;
     if (!ptr) {
-      // search through existing chunks for space
-      for (Chunk *chunk = head_; chunk; chunk = chunk->next) {
-        ptr = chunk->try_allocate(bytes, align);
-        if (ptr) {
-          current_ = chunk; // Update current to the chunk we found space in
-          break;
-        }
-      }
-      
-      // if no space found in existing chunks allocate a new one with progressive sizing
-      if (!ptr) {
-        const std::size_t current_chunk_size = current_->capacity;
-        const std::size_t next_chunk_size = std::min(current_chunk_size * 2, max_chunk_size_);
-        const std::size_t required_size = std::max(bytes, next_chunk_size);
-        current_ = current_->alloc_next(required_size);
-        ptr = current_->try_allocate(bytes, align);
-      }
+      ptr = allocate_slow(bytes, align, try_zeroed);
     }
 
-    // if the allocation can't be made
-    // throw bad_alloc
+    stats_.on_allocate(bytes);
+    return ptr;
+  }
+
+  // Fixed size and alignment: the fast path is resolved at compile time
+  template <std::size_t Size, std::size_t Align = alignof(std::max_align_t)>
+  void *allocate() {
+    std::lock_guard<ThreadPolicy> guard(lock_);
+
+    void *ptr = current_ ? current_->template try_allocate<Size, Align>() : nullptr;
     if (!ptr) {
-      throw std::bad_alloc();
+      ptr = allocate_slow(Size, Align, [](Chunk *chunk) {
+        return chunk->template try_allocate<Size, Align>();
+      });
     }
 
+    stats_.on_allocate(Size);
     return ptr;
   }
 
-  void reset() noexcept {
-    // iter over chunks and set each offset to 0
-    for (auto *c = head_; c; c = c->next)
+  // only feeds the stats, arena memory is reclaimed by reset()
+  void deallocate(void *, const std::size_t bytes) noexcept {
+    stats_.on_deallocate(bytes);
+  }
+
+  void reset(const ResetMode mode = ResetMode::Retain) noexcept {
+    std::lock_guard<ThreadPolicy> guard(lock_);
+    // iter over chunks and set each offset to 0, remembering how far
+    // the chunk has been written
+    for (auto *c = head_; c; c = c->next) {
+      c->dirty = std::max(c->dirty, c->offset);
       c->offset = 0;
+      if constexpr (DecommittingBacking<BackingPolicy>) {
+        if (mode == ResetMode::Decommit && c->dirty > 0 &&
+            backing_.decommit(c->memory, c->dirty)) {
+          c->dirty = 0;
+        }
+      }
+    }
     current_ = head_;
+    stats_.on_reset();
   }
-};
\ No newline at end of file
+
+  // true if p points into one of the arena's chunks
+  [[nodiscard]] bool contains(const void *p) const {
+    std::lock_guard<ThreadPolicy> guard(lock_);
+    const auto *byte = static_cast<const std::byte *>(p);
+    for (const Chunk *c = head_; c; c = c->next) {
+      if (byte >= c->memory && byte < c->memory + c->capacity) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  [[nodiscard]] const StatsPolicy &stats() const noexcept { return stats_; }
+
+private:
+  Chunk *new_chunk(const std::size_t size) {
+    std::byte *memory = backing_.allocate(size);
+    Chunk *chunk;
+    try {
+      chunk = new Chunk(memory, size, backing_is_zeroed<BackingPolicy>());
+    } catch (...) {
+      backing_.deallocate(memory, size);
+      throw;
+    }
+    stats_.on_chunk(size);
+    return chunk;
+  }
+
+  // the current chunk is full (or missing), try_chunk carves the
+  // allocation out of a chunk
+  template <typename TryChunk>
+  void *allocate_slow(const std::size_t bytes, const std::size_t align,
+                      TryChunk try_chunk) {
+    // over-aligned requests may need up to align - 1 bytes of padding
+    // in front of them, so fresh chunks must be able to absorb it
+    const std::size_t padded =
+        align > BackingPolicy::alignment ? bytes + align - 1 : bytes;
+
+    // if current is null allocate a new chunk
+    // set head and current to the new chunk
+    if (!current_) {
+      const std::size_t size = std::max(padded, initial_chunk_size_);
+      current_ = new_chunk(size);
+      head_ = current_;
+      return checked(try_chunk(current_));
+    }
+
+    // search through existing chunks for space
+    for (Chunk *chunk = head_; chunk; chunk = chunk->next) {
+      if (void *ptr = try_chunk(chunk)) {
+        current_ = chunk; // Update current to the chunk we found space in
+        return ptr;
+      }
+    }
+
+    // no space found in existing chunks, allocate a new one with
+    // progressive sizing after the last chunk
+    Chunk *tail = current_;
+    while (tail->next) {
+      tail = tail->next;
+    }
+    const std::size_t next_chunk_size =
+        GrowthPolicy::next_chunk_size(initial_chunk_size_, tail->capacity);
+    tail->next = new_chunk(std::max(padded, next_chunk_size));
+    current_ = tail->next;
+    return checked(try_chunk(current_));
+  }
+
+  // if the allocation can't be made throw bad_alloc
+  static void *checked(void *ptr) {
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+};
+
+using Arena = BasicArena<>;
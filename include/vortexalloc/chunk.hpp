@@ -2,22 +2,32 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
 
+// A block of arena memory with a bump offset. The memory itself is owned by
+// the arena that created the chunk.
 struct Chunk {
   Chunk *next;
   std::byte *memory;
   std::size_t capacity;
   std::size_t offset;
+  // everything at or past max(dirty, offset) is known to be zero, the arena
+  // folds offset into dirty on reset so plain allocations never touch it
+  std::size_t dirty;
 
-  explicit Chunk(const std::size_t capacity)
-      : next(nullptr), memory(new std::byte[capacity]), capacity(capacity),
-        offset(0) {}
-
-  ~Chunk() { delete[] memory; }
+  Chunk(std::byte *memory, const std::size_t capacity, const bool zeroed = false)
+      : next(nullptr), memory(memory), capacity(capacity), offset(0),
+        dirty(zeroed ? 0 : capacity) {}
 
   void *try_allocate(const std::size_t size,
                      const std::size_t align = alignof(std::max_align_t)) noexcept {
-    const std::size_t aligned_offset = (offset + align - 1) & ~(align - 1);
+    // align the address rather than the offset, the backing only guarantees
+    // its own alignment for the base of the chunk
+    const auto base = reinterpret_cast<std::uintptr_t>(memory);
+    const std::size_t aligned_offset =
+        ((base + offset + align - 1) & ~(align - 1)) - base;
     if (aligned_offset + size > capacity) {
       return nullptr;
     }
@@ -26,6 +36,41 @@ struct Chunk {
     return ptr;
   }
 
+  // size and alignment known at compile time, byte alignment needs no
+  // rounding at all and every other mask is a constant
+  template <std::size_t Size, std::size_t Align>
+  void *try_allocate() noexcept {
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+    std::size_t aligned_offset = offset;
+    if constexpr (Align > 1) {
+      const auto base = reinterpret_cast<std::uintptr_t>(memory);
+      aligned_offset = ((base + offset + Align - 1) & ~(Align - 1)) - base;
+    }
+    if (aligned_offset + Size > capacity) {
+      return nullptr;
+    }
+    void *ptr = memory + aligned_offset;
+    offset = aligned_offset + Size;
+    return ptr;
+  }
+
+  // like try_allocate but the memory reads as zero, only the part below the
+  // dirty mark is cleared
+  void *try_allocate_zeroed(const std::size_t size,
+                            const std::size_t align = alignof(std::max_align_t)) noexcept {
+    const std::size_t dirty_end = std::max(dirty, offset);
+    void *ptr = try_allocate(size, align);
+    if (!ptr) {
+      return nullptr;
+    }
+    const std::size_t begin = static_cast<std::byte *>(ptr) - memory;
+    if (begin < dirty_end) {
+      std::memset(ptr, 0, std::min(begin + size, dirty_end) - begin);
+    }
+    return ptr;
+  }
+
   void *allocate(std::size_t size,
                  std::size_t align = alignof(std::max_align_t)) {
     void *ptr = try_allocate(size, align);
@@ -34,9 +79,4 @@ struct Chunk {
     }
     return ptr;
   }
-
-  Chunk *alloc_next(std::size_t obj_size) noexcept {
-    next = new Chunk(std::max(obj_size, capacity));
-    return next;
-  }
-};
\ No newline at end of file
+};
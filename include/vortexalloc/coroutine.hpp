@@ -0,0 +1,155 @@
+#pragma once
+
+#include "arena.hpp"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// Arena backed storage for coroutine frames.
+//
+// Frames are rounded up to a multiple of kBucketBytes and released frames are
+// kept on a free list per bucket, so a coroutine that is called over and over
+// reuses the same few frames. Frames larger than the biggest bucket go to the
+// global heap, in the arena they could only be reclaimed by reset().
+//
+// ThreadPolicy guards the free lists and the arena. The default FrameArena
+// is single threaded, so it and every frame it hands out must stay on one
+// thread. Coroutines that are resumed or destroyed on other threads need a
+// SharedFrameArena.
+template <typename ThreadPolicy = SingleThreaded> class BasicFrameArena {
+private:
+  static constexpr std::size_t kBucketBytes = 64;
+  static constexpr std::size_t kBuckets = 64; // recycle frames up to 4KB
+
+  struct FreeFrame {
+    FreeFrame *next;
+  };
+
+  Arena arena_;
+  std::array<FreeFrame *, kBuckets> free_{};
+  [[no_unique_address]] ThreadPolicy lock_;
+
+  // out of line for the same -Wmismatched-new-delete reason as in
+  // BasicArenaFramePromise
+  [[gnu::noinline]] static void *heap_allocate(const std::size_t bytes) {
+    return ::operator new(bytes);
+  }
+
+  static std::size_t bucket_of(const std::size_t bytes) noexcept {
+    return (std::max<std::size_t>(bytes, 1) + kBucketBytes - 1) /
+               kBucketBytes -
+           1;
+  }
+
+public:
+  using thread_policy = ThreadPolicy;
+
+  static constexpr std::size_t frame_align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  explicit BasicFrameArena(const std::size_t chunk_size) : arena_(chunk_size) {}
+
+  BasicFrameArena() = default;
+
+  BasicFrameArena(const BasicFrameArena &) = delete;
+  BasicFrameArena &operator=(const BasicFrameArena &) = delete;
+
+  void *allocate(const std::size_t bytes) {
+    const std::size_t bucket = bucket_of(bytes);
+    if (bucket >= kBuckets) {
+      return heap_allocate(bytes);
+    }
+
+    std::lock_guard<ThreadPolicy> guard(lock_);
+    if (FreeFrame *frame = free_[bucket]) {
+      free_[bucket] = frame->next;
+      return frame;
+    }
+    return arena_.allocate((bucket + 1) * kBucketBytes, frame_align);
+  }
+
+  void deallocate(void *p, const std::size_t bytes) noexcept {
+    const std::size_t bucket = bucket_of(bytes);
+    if (bucket >= kBuckets) {
+      ::operator delete(p, bytes);
+      return;
+    }
+
+    std::lock_guard<ThreadPolicy> guard(lock_);
+    auto *frame = static_cast<FreeFrame *>(p);
+    frame->next = free_[bucket];
+    free_[bucket] = frame;
+  }
+
+  // every frame handed out must already be destroyed
+  void reset() noexcept {
+    std::lock_guard<ThreadPolicy> guard(lock_);
+    free_.fill(nullptr);
+    arena_.reset();
+  }
+
+  [[nodiscard]] const Arena &arena() const noexcept { return arena_; }
+};
+
+using FrameArena = BasicFrameArena<>;
+using SharedFrameArena = BasicFrameArena<MutexLocked>;
+
+// Promise mixin that places the coroutine frame in a Frames arena.
+//
+// A coroutine whose promise_type derives from BasicArenaFramePromise gets its
+// frame from the Frames arena passed as its first parameter, or as its second
+// parameter when the first one is of class type (the object of a member
+// coroutine, or any other class argument of a free coroutine). Without one
+// the frame falls back to the global heap. Each frame is prefixed with the
+// owning Frames arena so that operator delete can route it back.
+template <typename Frames = FrameArena> struct BasicArenaFramePromise {
+private:
+  static constexpr std::size_t kHeader = Frames::frame_align;
+
+  static_assert(sizeof(Frames *) <= kHeader);
+
+  // GCC's -Wmismatched-new-delete pairs the frame's operator delete with
+  // whatever allocation it can see. Inlining the placement overloads and
+  // keeping ::operator new out of line leaves it nothing to mismatch.
+  [[gnu::noinline]] static void *heap_allocate(const std::size_t bytes) {
+    return ::operator new(bytes);
+  }
+
+  static void *allocate_frame(const std::size_t size, Frames *owner) {
+    void *mem = owner ? owner->allocate(size + kHeader)
+                      : heap_allocate(size + kHeader);
+    *static_cast<Frames **>(mem) = owner;
+    return static_cast<std::byte *>(mem) + kHeader;
+  }
+
+public:
+  template <typename... Args>
+  [[gnu::always_inline]] static void *
+  operator new(const std::size_t size, Frames &frames, Args &...) {
+    return allocate_frame(size, &frames);
+  }
+
+  template <typename Self, typename... Args>
+    requires(std::is_class_v<Self> && !std::is_same_v<Self, Frames>)
+  [[gnu::always_inline]] static void *
+  operator new(const std::size_t size, Self &, Frames &frames, Args &...) {
+    return allocate_frame(size, &frames);
+  }
+
+  static void *operator new(const std::size_t size) {
+    return allocate_frame(size, nullptr);
+  }
+
+  static void operator delete(void *p, const std::size_t size) noexcept {
+    void *mem = static_cast<std::byte *>(p) - kHeader;
+    if (Frames *owner = *static_cast<Frames **>(mem)) {
+      owner->deallocate(mem, size + kHeader);
+    } else {
+      ::operator delete(mem, size + kHeader);
+    }
+  }
+};
+
+using ArenaFramePromise = BasicArenaFramePromise<>;
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "arena.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Fixed-size object pool carved out of Arena chunks.
+//
+// Objects live in slabs whose size is a power of two and which are aligned to
+// that size, so the owning slab of any object is found by masking its address.
+// Each slab keeps an occupancy bitmap of its live slots. Freed slots are
+// pushed onto an intrusive LIFO free list and handed out again first.
+template <typename T> class ObjectPool {
+private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  static constexpr std::size_t kSlotAlign =
+      std::max(alignof(T), alignof(void *));
+  static constexpr std::size_t kSlotSize =
+      (std::max(sizeof(T), sizeof(void *)) + kSlotAlign - 1) &
+      ~(kSlotAlign - 1);
+
+  // at least 16KB and always room for a couple of bitmap words of slots
+  static constexpr std::size_t kSlabBytes = std::bit_ceil(
+      std::max<std::size_t>(16 * 1024, kCacheLine + 128 * kSlotSize));
+
+  static constexpr std::size_t kMaxSlots = kSlabBytes / kSlotSize;
+  static constexpr std::size_t kWords = (kMaxSlots + 63) / 64;
+
+  struct FreeSlot {
+    FreeSlot *next;
+  };
+
+  struct Slab {
+    Slab *next;
+    std::size_t live;
+    std::size_t bump;
+    std::uint64_t occupied[kWords];
+  };
+
+  // slots start on the first cache line after the header
+  static constexpr std::size_t kHeaderBytes =
+      (sizeof(Slab) + std::max(kCacheLine, kSlotAlign) - 1) &
+      ~(std::max(kCacheLine, kSlotAlign) - 1);
+  static constexpr std::size_t kSlotsPerSlab =
+      (kSlabBytes - kHeaderBytes) / kSlotSize;
+
+  static_assert(kSlotsPerSlab > 0, "object too large for a pool slab");
+
+  Arena arena_;
+  Slab *slabs_ = nullptr;
+  Slab *current_ = nullptr;
+  FreeSlot *free_ = nullptr;
+  std::size_t live_ = 0;
+
+  static std::byte *slot_at(Slab *slab, const std::size_t index) noexcept {
+    return reinterpret_cast<std::byte *>(slab) + kHeaderBytes +
+           index * kSlotSize;
+  }
+
+  static Slab *slab_of(const void *p) noexcept {
+    return reinterpret_cast<Slab *>(reinterpret_cast<std::uintptr_t>(p) &
+                                    ~(kSlabBytes - 1));
+  }
+
+  static std::size_t index_of(Slab *slab, const void *p) noexcept {
+    return (static_cast<const std::byte *>(p) - slot_at(slab, 0)) / kSlotSize;
+  }
+
+  Slab *new_slab() {
+    void *mem = arena_.allocate(kSlabBytes, kSlabBytes);
+    auto *slab = ::new (mem) Slab{slabs_, 0, 0, {}};
+    slabs_ = slab;
+    return slab;
+  }
+
+  void destroy_live() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for_each_live([](T &obj) { obj.~T(); });
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr std::size_t slots_per_slab = kSlotsPerSlab;
+
+  // slabs_per_chunk controls the size of the first arena chunk
+  explicit ObjectPool(const std::size_t slabs_per_chunk)
+      : arena_(kSlabBytes * std::max<std::size_t>(slabs_per_chunk, 2)) {}
+
+  ObjectPool() : ObjectPool(8) {}
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  ~ObjectPool() { destroy_live(); }
+
+  // returns uninitialized storage for one T
+  [[nodiscard]] T *allocate() {
+    std::byte *slot;
+    if (free_) {
+      slot = reinterpret_cast<std::byte *>(free_);
+      free_ = free_->next;
+    } else {
+      if (!current_ || current_->bump == kSlotsPerSlab) {
+        current_ = new_slab();
+      }
+      slot = slot_at(current_, current_->bump++);
+    }
+
+    Slab *slab = slab_of(slot);
+    const std::size_t index = index_of(slab, slot);
+    slab->occupied[index / 64] |= std::uint64_t{1} << (index % 64);
+    ++slab->live;
+    ++live_;
+    return reinterpret_cast<T *>(slot);
+  }
+
+  // returns the storage of p to the pool, p must already be destroyed
+  void deallocate(T *p) noexcept {
+    Slab *slab = slab_of(p);
+    const std::size_t index = index_of(slab, p);
+    slab->occupied[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+    --slab->live;
+    --live_;
+
+    auto *slot = reinterpret_cast<FreeSlot *>(p);
+    slot->next = free_;
+    free_ = slot;
+  }
+
+  template <typename... Args> [[nodiscard]] T *create(Args &&...args) {
+    T *p = allocate();
+    try {
+      return ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(p);
+      throw;
+    }
+  }
+
+  void destroy(T *p) noexcept {
+    p->~T();
+    deallocate(p);
+  }
+
+  // visits every live object slab by slab, skipping empty slabs and empty
+  // bitmap words
+  template <typename F> void for_each_live(F &&f) {
+    for (Slab *slab = slabs_; slab; slab = slab->next) {
+      if (slab->live == 0) {
+        continue;
+      }
+      for (std::size_t w = 0; w < kWords; ++w) {
+        std::uint64_t bits = slab->occupied[w];
+        while (bits) {
+          const std::size_t index = w * 64 + std::countr_zero(bits);
+          f(*std::launder(reinterpret_cast<T *>(slot_at(slab, index))));
+          bits &= bits - 1;
+        }
+      }
+    }
+  }
+
+  template <typename F> void for_each_live(F &&f) const {
+    const_cast<ObjectPool *>(this)->for_each_live(
+        [&f](const T &obj) { f(obj); });
+  }
+
+  [[nodiscard]] size_type size() const noexcept { return live_; }
+
+  [[nodiscard]] bool empty() const noexcept { return live_ == 0; }
+
+  // destroys every live object and rewinds the arena for reuse
+  void clear() noexcept {
+    destroy_live();
+    arena_.reset();
+    slabs_ = nullptr;
+    current_ = nullptr;
+    free_ = nullptr;
+    live_ = 0;
+  }
+};
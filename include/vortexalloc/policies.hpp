@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+
+// Policies for BasicArena. Each one is resolved at compile time, so the
+// defaults compile down to the same code the plain Arena always had.
+
+// --- growth: size of the next chunk given the arena's initial chunk size
+// and the capacity of the last chunk
+
+// double the chunk size up to MaxChunkSize
+template <std::size_t MaxChunkSize = 1024 * 1024> struct DoublingGrowth {
+  static constexpr std::size_t next_chunk_size(std::size_t,
+                                               const std::size_t current) noexcept {
+    return std::min(current * 2, MaxChunkSize);
+  }
+};
+
+// every chunk has the initial size, oversized requests still get a chunk of
+// their own but do not change the size of the ones after it
+struct FixedGrowth {
+  static constexpr std::size_t next_chunk_size(const std::size_t initial,
+                                               std::size_t) noexcept {
+    return initial;
+  }
+};
+
+// --- backing: where chunk memory comes from
+//
+// A backing may declare `static constexpr bool zeroed = true` when fresh
+// chunks are guaranteed to read as zero, and may provide
+// `bool decommit(std::byte *, std::size_t)` to hand a dirty prefix of a
+// chunk back to the OS so it reads as zero again.
+
+// plain new[], aligned to alignof(std::max_align_t)
+struct NewBacking {
+  static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+  std::byte *allocate(const std::size_t size) { return new std::byte[size]; }
+
+  void deallocate(std::byte *memory, std::size_t) noexcept { delete[] memory; }
+};
+
+// aligned operator new, e.g. to start every chunk on a cache line
+template <std::size_t Align> struct AlignedNewBacking {
+  static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+  static constexpr std::size_t alignment = Align;
+
+  std::byte *allocate(const std::size_t size) {
+    return static_cast<std::byte *>(::operator new(size, std::align_val_t{Align}));
+  }
+
+  void deallocate(std::byte *memory, std::size_t) noexcept {
+    ::operator delete(memory, std::align_val_t{Align});
+  }
+};
+
+// calloc, zero for free whenever glibc serves the chunk from fresh pages
+struct CallocBacking {
+  static constexpr std::size_t alignment = alignof(std::max_align_t);
+  static constexpr bool zeroed = true;
+
+  std::byte *allocate(const std::size_t size) {
+    void *memory = std::calloc(size, 1);
+    if (!memory) {
+      throw std::bad_alloc();
+    }
+    return static_cast<std::byte *>(memory);
+  }
+
+  void deallocate(std::byte *memory, std::size_t) noexcept {
+    std::free(memory);
+  }
+};
+
+// anonymous mmap, chunks are fresh zero pages and a reset can drop dirty
+// pages with MADV_DONTNEED once at least MinDecommit bytes are dirty
+template <std::size_t MinDecommit = 64 * 1024> struct MmapBacking {
+  static constexpr std::size_t alignment = 4096;
+  static constexpr bool zeroed = true;
+
+  std::byte *allocate(const std::size_t size) {
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    return static_cast<std::byte *>(memory);
+  }
+
+  void deallocate(std::byte *memory, const std::size_t size) noexcept {
+    munmap(memory, size);
+  }
+
+  // the mapping covers whole pages, so rounding up stays inside it
+  bool decommit(std::byte *memory, const std::size_t bytes) noexcept {
+    if (bytes < MinDecommit) {
+      return false;
+    }
+    const std::size_t length = (bytes + alignment - 1) & ~(alignment - 1);
+    return madvise(memory, length, MADV_DONTNEED) == 0;
+  }
+};
+
+template <typename Backing> constexpr bool backing_is_zeroed() noexcept {
+  if constexpr (requires { Backing::zeroed; }) {
+    return Backing::zeroed;
+  } else {
+    return false;
+  }
+}
+
+template <typename Backing>
+concept DecommittingBacking =
+    requires(Backing &backing, std::byte *memory, std::size_t bytes) {
+      { backing.decommit(memory, bytes) } -> std::same_as<bool>;
+    };
+
+// --- threading: guards allocate() and reset(), used through std::lock_guard
+
+// no synchronization, the arena belongs to a single thread
+struct SingleThreaded {
+  void lock() noexcept {}
+  void unlock() noexcept {}
+};
+
+// one mutex around every arena operation
+struct MutexLocked {
+  std::mutex mutex;
+
+  void lock() { mutex.lock(); }
+  void unlock() noexcept { mutex.unlock(); }
+};
+
+// --- stats: hooks called by the arena
+
+struct NoStats {
+  void on_allocate(std::size_t) noexcept {}
+  void on_deallocate(std::size_t) noexcept {}
+  void on_chunk(std::size_t) noexcept {}
+  void on_reset() noexcept {}
+};
+
+struct CountingStats {
+  std::size_t allocations = 0;
+  std::size_t bytes_requested = 0;
+  // bytes handed back through ChunkAllocator::deallocate, they stay dead
+  // in the arena until the next reset
+  std::size_t bytes_released = 0;
+  std::size_t bytes_reserved = 0;
+  std::size_t chunks = 0;
+  std::size_t resets = 0;
+
+  void on_allocate(const std::size_t bytes) noexcept {
+    ++allocations;
+    bytes_requested += bytes;
+  }
+  void on_deallocate(const std::size_t bytes) noexcept {
+    bytes_released += bytes;
+  }
+  void on_chunk(const std::size_t capacity) noexcept {
+    ++chunks;
+    bytes_reserved += capacity;
+  }
+  void on_reset() noexcept { ++resets; }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "arena.hpp"
+
+#include <dlfcn.h>
+
+// Provided by the redirection shim, either the LD_PRELOAD library
+// (vortexalloc_preload) or the operator new override (vortexalloc_redirect_new).
+// Swaps the calling thread's active arena and returns the previous one.
+extern "C" Arena *vortex_redirect_exchange(Arena *arena) __attribute__((weak));
+
+// Routes malloc/operator new on the current thread into arena for the
+// lifetime of the guard. Guards nest. Memory handed out this way belongs to
+// the arena: free/delete of it is a no-op and it is reclaimed by reset() or
+// by destroying the arena, which must outlive every use of it.
+//
+// Without a shim loaded into the process the guard does nothing.
+class ScopedArenaRedirect {
+private:
+  using Exchange = Arena *(*)(Arena *);
+
+  Arena *previous_;
+
+  static Exchange resolve() noexcept {
+    // linked in statically, or else interposed through LD_PRELOAD
+    static const Exchange exchange = []() -> Exchange {
+      if (vortex_redirect_exchange) {
+        return &vortex_redirect_exchange;
+      }
+      return reinterpret_cast<Exchange>(
+          dlsym(RTLD_DEFAULT, "vortex_redirect_exchange"));
+    }();
+    return exchange;
+  }
+
+  static Arena *exchange(Arena *arena) noexcept {
+    const Exchange fn = resolve();
+    return fn ? fn(arena) : nullptr;
+  }
+
+public:
+  explicit ScopedArenaRedirect(Arena &arena) : previous_(exchange(&arena)) {}
+
+  ~ScopedArenaRedirect() { exchange(previous_); }
+
+  ScopedArenaRedirect(const ScopedArenaRedirect &) = delete;
+  ScopedArenaRedirect &operator=(const ScopedArenaRedirect &) = delete;
+
+  // true when a shim is present and the guard actually redirects
+  [[nodiscard]] static bool available() noexcept { return resolve() != nullptr; }
+};
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "allocator.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Vector whose elements never move.
+//
+// Storage is a list of segments that double in size, segment k holds
+// first_segment << k elements. Growing adds a segment instead of
+// reallocating, so no dead buffers are left in the arena and pointers to
+// elements stay valid until the element is removed. Indexing maps an index
+// to its segment with a bit scan over a small segment table.
+template <typename T, typename Allocator = ChunkAllocator<T>>
+class SegmentedVector {
+private:
+  using alloc_type =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using traits = std::allocator_traits<alloc_type>;
+
+public:
+  using value_type = T;
+  using allocator_type = alloc_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  // at least a few cache lines worth of elements in the first segment
+  static constexpr size_type first_segment =
+      std::bit_ceil(std::max<size_type>(16, 256 / sizeof(T)));
+
+private:
+  static constexpr unsigned kFirstBits = std::countr_zero(first_segment);
+  static constexpr size_type kMaxSegments =
+      std::numeric_limits<size_type>::digits - kFirstBits;
+
+  [[no_unique_address]] alloc_type alloc_;
+  std::array<T *, kMaxSegments> segments_{};
+  size_type segment_count_ = 0;
+  size_type size_ = 0;
+  // next free slot and the end of the segment it lives in
+  T *end_ = nullptr;
+  T *segment_end_ = nullptr;
+
+  static constexpr size_type segment_size(const size_type k) noexcept {
+    return first_segment << k;
+  }
+
+  struct Location {
+    size_type segment;
+    size_type offset;
+  };
+
+  static Location locate(const size_type index) noexcept {
+    const size_type biased = index + first_segment;
+    const size_type segment = std::bit_width(biased) - 1 - kFirstBits;
+    return {segment, biased - segment_size(segment)};
+  }
+
+  void add_segment() {
+    if (segment_count_ == kMaxSegments) {
+      throw std::length_error("SegmentedVector is full");
+    }
+    segments_[segment_count_] =
+        traits::allocate(alloc_, segment_size(segment_count_));
+    ++segment_count_;
+  }
+
+  // points end_ at the slot for index size_
+  void seek_end() {
+    const Location loc = locate(size_);
+    if (loc.segment == segment_count_) {
+      add_segment();
+    }
+    end_ = segments_[loc.segment] + loc.offset;
+    segment_end_ = segments_[loc.segment] + segment_size(loc.segment);
+  }
+
+  void release() noexcept {
+    clear();
+    for (size_type k = 0; k < segment_count_; ++k) {
+      traits::deallocate(alloc_, segments_[k], segment_size(k));
+    }
+    segments_.fill(nullptr);
+    segment_count_ = 0;
+  }
+
+  template <bool Const> class Iterator {
+  private:
+    using owner_type =
+        std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+
+    owner_type *owner_ = nullptr;
+    size_type index_ = 0;
+
+    friend class SegmentedVector;
+
+    Iterator(owner_type *owner, const size_type index) noexcept
+        : owner_(owner), index_(index) {}
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+
+    // iterator converts to const_iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false> &other) noexcept
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const noexcept { return (*owner_)[index_]; }
+    pointer operator->() const noexcept { return &(*owner_)[index_]; }
+    reference operator[](const difference_type n) const noexcept {
+      return (*owner_)[index_ + n];
+    }
+
+    Iterator &operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      ++index_;
+      return tmp;
+    }
+    Iterator &operator--() noexcept {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) noexcept {
+      Iterator tmp = *this;
+      --index_;
+      return tmp;
+    }
+    Iterator &operator+=(const difference_type n) noexcept {
+      index_ += n;
+      return *this;
+    }
+    Iterator &operator-=(const difference_type n) noexcept {
+      index_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, const difference_type n) noexcept {
+      return it += n;
+    }
+    friend Iterator operator+(const difference_type n, Iterator it) noexcept {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, const difference_type n) noexcept {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator &a,
+                                     const Iterator &b) noexcept {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b) noexcept {
+      return a.index_ == b.index_;
+    }
+    friend auto operator<=>(const Iterator &a, const Iterator &b) noexcept {
+      return a.index_ <=> b.index_;
+    }
+
+    template <bool> friend class Iterator;
+  };
+
+public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SegmentedVector() = default;
+
+  explicit SegmentedVector(const Allocator &alloc) : alloc_(alloc) {}
+
+  SegmentedVector(const SegmentedVector &) = delete;
+  SegmentedVector &operator=(const SegmentedVector &) = delete;
+
+  SegmentedVector(SegmentedVector &&other) noexcept
+      : alloc_(other.alloc_), segments_(std::exchange(other.segments_, {})),
+        segment_count_(std::exchange(other.segment_count_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        end_(std::exchange(other.end_, nullptr)),
+        segment_end_(std::exchange(other.segment_end_, nullptr)) {}
+
+  SegmentedVector &operator=(SegmentedVector &&other) noexcept {
+    if (this != &other) {
+      release();
+      alloc_ = other.alloc_;
+      segments_ = std::exchange(other.segments_, {});
+      segment_count_ = std::exchange(other.segment_count_, 0);
+      size_ = std::exchange(other.size_, 0);
+      end_ = std::exchange(other.end_, nullptr);
+      segment_end_ = std::exchange(other.segment_end_, nullptr);
+    }
+    return *this;
+  }
+
+  ~SegmentedVector() { release(); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (end_ == segment_end_) {
+      seek_end();
+    }
+    traits::construct(alloc_, end_, std::forward<Args>(args)...);
+    ++size_;
+    return *end_++;
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept {
+    --size_;
+    const Location loc = locate(size_);
+    end_ = segments_[loc.segment] + loc.offset;
+    segment_end_ = segments_[loc.segment] + segment_size(loc.segment);
+    traits::destroy(alloc_, end_);
+  }
+
+  // destroys the elements but keeps the segments for reuse
+  void clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for_each_segment([this](T *data, const size_type count) {
+        for (size_type i = 0; i < count; ++i) {
+          traits::destroy(alloc_, data + i);
+        }
+      });
+    }
+    size_ = 0;
+    end_ = nullptr;
+    segment_end_ = nullptr;
+  }
+
+  void reserve(const size_type n) {
+    while (capacity() < n) {
+      add_segment();
+    }
+  }
+
+  reference operator[](const size_type index) noexcept {
+    const Location loc = locate(index);
+    return segments_[loc.segment][loc.offset];
+  }
+
+  const_reference operator[](const size_type index) const noexcept {
+    const Location loc = locate(index);
+    return segments_[loc.segment][loc.offset];
+  }
+
+  reference at(const size_type index) {
+    if (index >= size_) {
+      throw std::out_of_range("SegmentedVector::at");
+    }
+    return (*this)[index];
+  }
+
+  const_reference at(const size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("SegmentedVector::at");
+    }
+    return (*this)[index];
+  }
+
+  reference front() noexcept { return *segments_[0]; }
+  const_reference front() const noexcept { return *segments_[0]; }
+  reference back() noexcept { return (*this)[size_ - 1]; }
+  const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] size_type capacity() const noexcept {
+    return segment_size(segment_count_) - first_segment;
+  }
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // number of segments holding at least one element
+  [[nodiscard]] size_type segment_count() const noexcept {
+    return size_ == 0 ? 0 : locate(size_ - 1).segment + 1;
+  }
+
+  // the elements of segment k as one contiguous span
+  [[nodiscard]] std::span<T> segment(const size_type k) noexcept {
+    const size_type begin = segment_size(k) - first_segment;
+    return {segments_[k], std::min(segment_size(k), size_ - begin)};
+  }
+
+  [[nodiscard]] std::span<const T> segment(const size_type k) const noexcept {
+    const size_type begin = segment_size(k) - first_segment;
+    return {segments_[k], std::min(segment_size(k), size_ - begin)};
+  }
+
+  // calls f(data, count) once per contiguous run of elements, the inner loop
+  // over data is a plain array loop the compiler can vectorize
+  template <typename F> void for_each_segment(F &&f) {
+    const size_type used = segment_count();
+    for (size_type k = 0; k < used; ++k) {
+      const std::span<T> s = segment(k);
+      f(s.data(), s.size());
+    }
+  }
+
+  template <typename F> void for_each_segment(F &&f) const {
+    const size_type used = segment_count();
+    for (size_type k = 0; k < used; ++k) {
+      const std::span<const T> s = segment(k);
+      f(s.data(), s.size());
+    }
+  }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size_}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size_}; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+};
@@ -0,0 +1,255 @@
+#include "redirect_core.hpp"
+
+#include "vortexalloc/arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+void *__libc_memalign(std::size_t align, std::size_t size);
+void __libc_free(void *p);
+}
+
+namespace {
+
+struct ThreadState {
+  Arena *arena;
+  // set while the shim itself is inside the arena, so the arena's own
+  // chunk allocations fall through to glibc
+  bool busy;
+  const Chunk *last_chunk;
+};
+
+// initial-exec TLS never allocates, which matters inside malloc
+constinit thread_local ThreadState state
+    __attribute__((tls_model("initial-exec"))) = {nullptr, false, nullptr};
+
+// Every handed out pointer is preceded by the requested size, which keeps
+// user pointers strictly inside their chunk and lets realloc copy.
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+
+// Address ranges of arena chunks that served redirected allocations. A chunk
+// stays registered until its memory is given back to glibc by the arena.
+constexpr std::size_t kMaxRanges = 4096;
+
+struct Range {
+  std::atomic<std::uintptr_t> begin{0};
+  std::atomic<std::uintptr_t> end{0};
+};
+
+Range ranges[kMaxRanges];
+std::atomic<std::size_t> range_count{0};
+std::atomic<std::uintptr_t> lowest{std::numeric_limits<std::uintptr_t>::max()};
+std::atomic<std::uintptr_t> highest{0};
+std::atomic_flag registry_lock = ATOMIC_FLAG_INIT;
+
+struct RegistryGuard {
+  RegistryGuard() noexcept {
+    while (registry_lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~RegistryGuard() { registry_lock.clear(std::memory_order_release); }
+};
+
+bool in_bounds(const std::uintptr_t addr) noexcept {
+  return addr >= lowest.load(std::memory_order_relaxed) &&
+         addr < highest.load(std::memory_order_relaxed);
+}
+
+// false when the registry is full, memory from an unregistered chunk must
+// not be handed out since free() would pass it on to glibc
+bool register_chunk(const Chunk *chunk) noexcept {
+  const auto begin = reinterpret_cast<std::uintptr_t>(chunk->memory);
+  const auto end = begin + chunk->capacity;
+
+  RegistryGuard guard;
+  const std::size_t count = range_count.load(std::memory_order_relaxed);
+  std::size_t slot = count;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uintptr_t b = ranges[i].begin.load(std::memory_order_relaxed);
+    if (b == begin) {
+      return true;
+    }
+    if (b == 0 && slot == count) {
+      slot = i;
+    }
+  }
+  if (slot == kMaxRanges) {
+    return false;
+  }
+
+  ranges[slot].end.store(end, std::memory_order_relaxed);
+  ranges[slot].begin.store(begin, std::memory_order_release);
+  if (slot == count) {
+    range_count.store(count + 1, std::memory_order_release);
+  }
+  if (begin < lowest.load(std::memory_order_relaxed)) {
+    lowest.store(begin, std::memory_order_relaxed);
+  }
+  if (end > highest.load(std::memory_order_relaxed)) {
+    highest.store(end, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+enum class Lookup { Foreign, Inside, ChunkBase };
+
+// lock-free pass over the registry
+Lookup lookup(const std::uintptr_t addr) noexcept {
+  if (!in_bounds(addr)) {
+    return Lookup::Foreign;
+  }
+
+  const std::size_t count = range_count.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uintptr_t begin = ranges[i].begin.load(std::memory_order_acquire);
+    if (begin == 0 || addr < begin) {
+      continue;
+    }
+    // chunk bases are never handed out, they belong to the arena itself
+    if (addr == begin) {
+      return Lookup::ChunkBase;
+    }
+    if (addr < ranges[i].end.load(std::memory_order_relaxed)) {
+      return Lookup::Inside;
+    }
+  }
+  return Lookup::Foreign;
+}
+
+// the arena is returning a chunk, addr is the chunk base
+void forget_chunk(const std::uintptr_t addr) noexcept {
+  RegistryGuard guard;
+  const std::size_t count = range_count.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (ranges[i].begin.load(std::memory_order_relaxed) == addr) {
+      ranges[i].begin.store(0, std::memory_order_release);
+      ranges[i].end.store(0, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+void *libc_allocate(const std::size_t size, const std::size_t align) noexcept {
+  return align <= alignof(std::max_align_t) ? __libc_malloc(size)
+                                            : __libc_memalign(align, size);
+}
+
+void *arena_allocate(Arena *arena, const std::size_t size,
+                     const std::size_t requested_align) noexcept {
+  const std::size_t align = std::max(requested_align, kHeader);
+  if (size > std::numeric_limits<std::size_t>::max() - align) {
+    return nullptr;
+  }
+
+  state.busy = true;
+  std::byte *base;
+  try {
+    base = static_cast<std::byte *>(arena->allocate(size + align, align));
+  } catch (...) {
+    state.busy = false;
+    return nullptr;
+  }
+  if (arena->current_ != state.last_chunk) {
+    if (!register_chunk(arena->current_)) {
+      // no room to track the chunk, this request goes to glibc and the
+      // chunk is retried on the next one
+      state.busy = false;
+      return libc_allocate(size, requested_align);
+    }
+    state.last_chunk = arena->current_;
+  }
+  state.busy = false;
+
+  std::byte *user = base + align;
+  *reinterpret_cast<std::size_t *>(user - kHeader) = size;
+  return user;
+}
+
+Arena *active_arena() noexcept {
+  return state.busy ? nullptr : state.arena;
+}
+
+} // namespace
+
+extern "C" Arena *vortex_redirect_exchange(Arena *arena) {
+  Arena *previous = state.arena;
+  state.arena = arena;
+  state.last_chunk = nullptr;
+  return previous;
+}
+
+namespace redirect {
+
+bool owns(const void *p) noexcept {
+  return lookup(reinterpret_cast<std::uintptr_t>(p)) == Lookup::Inside;
+}
+
+std::size_t requested_size(const void *p) noexcept {
+  return *reinterpret_cast<const std::size_t *>(
+      static_cast<const std::byte *>(p) - kHeader);
+}
+
+void *allocate(const std::size_t size, const std::size_t align) noexcept {
+  if (Arena *arena = active_arena()) {
+    return arena_allocate(arena, size, align);
+  }
+  return libc_allocate(size, align);
+}
+
+void *allocate_zeroed(const std::size_t count, const std::size_t size) noexcept {
+  if (Arena *arena = active_arena()) {
+    std::size_t bytes;
+    if (__builtin_mul_overflow(count, size, &bytes)) {
+      return nullptr;
+    }
+    // arena memory is reused after reset(), so it has to be cleared
+    void *p = arena_allocate(arena, bytes, kHeader);
+    if (p) {
+      std::memset(p, 0, bytes);
+    }
+    return p;
+  }
+  return __libc_calloc(count, size);
+}
+
+void *reallocate(void *p, const std::size_t size) noexcept {
+  if (!p) {
+    return allocate(size, alignof(std::max_align_t));
+  }
+  if (!owns(p)) {
+    return __libc_realloc(p, size);
+  }
+
+  // arena memory never grows in place, move it to a fresh block
+  void *fresh = allocate(size, alignof(std::max_align_t));
+  if (fresh) {
+    std::memcpy(fresh, p, std::min(size, requested_size(p)));
+  }
+  return fresh;
+}
+
+void release(void *p) noexcept {
+  if (!p) {
+    return;
+  }
+  // only frees of registered chunk bases take the registry lock, every
+  // other glibc pointer goes straight through
+  const auto addr = reinterpret_cast<std::uintptr_t>(p);
+  const Lookup where = lookup(addr);
+  if (where == Lookup::Inside) {
+    return;
+  }
+  if (where == Lookup::ChunkBase) {
+    forget_chunk(addr);
+  }
+  __libc_free(p);
+}
+
+} // namespace redirect
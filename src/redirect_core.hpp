@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+// Shared core of the allocation redirection shim. While a thread has an
+// active arena its allocations are carved out of it with a small size header;
+// every other request goes straight to glibc.
+namespace redirect {
+
+void *allocate(std::size_t size, std::size_t align) noexcept;
+
+void *allocate_zeroed(std::size_t count, std::size_t size) noexcept;
+
+void *reallocate(void *p, std::size_t size) noexcept;
+
+// a no-op for arena memory
+void release(void *p) noexcept;
+
+// true if p was handed out from an arena by the shim
+bool owns(const void *p) noexcept;
+
+// size requested for a pointer that owns() accepts
+std::size_t requested_size(const void *p) noexcept;
+
+} // namespace redirect
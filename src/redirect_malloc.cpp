@@ -0,0 +1,55 @@
+// malloc family overrides for the LD_PRELOAD build of the redirection shim
+
+#include "redirect_core.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <dlfcn.h>
+
+extern "C" {
+
+void *malloc(std::size_t size) {
+  return redirect::allocate(size, alignof(std::max_align_t));
+}
+
+void free(void *p) { redirect::release(p); }
+
+void *calloc(std::size_t count, std::size_t size) {
+  return redirect::allocate_zeroed(count, size);
+}
+
+void *realloc(void *p, std::size_t size) {
+  return redirect::reallocate(p, size);
+}
+
+void *memalign(std::size_t align, std::size_t size) {
+  return redirect::allocate(size, align);
+}
+
+void *aligned_alloc(std::size_t align, std::size_t size) {
+  return redirect::allocate(size, align);
+}
+
+int posix_memalign(void **out, std::size_t align, std::size_t size) {
+  if (align < sizeof(void *) || (align & (align - 1)) != 0) {
+    return EINVAL;
+  }
+  void *p = redirect::allocate(size, align);
+  if (!p) {
+    return ENOMEM;
+  }
+  *out = p;
+  return 0;
+}
+
+std::size_t malloc_usable_size(void *p) {
+  if (redirect::owns(p)) {
+    return redirect::requested_size(p);
+  }
+  using UsableSize = std::size_t (*)(void *);
+  static const auto next =
+      reinterpret_cast<UsableSize>(dlsym(RTLD_NEXT, "malloc_usable_size"));
+  return next ? next(p) : 0;
+}
+
+} // extern "C"
@@ -0,0 +1,98 @@
+// Global operator new/delete overrides for linking the redirection shim
+// straight into an executable, no LD_PRELOAD needed. Only C++ allocations
+// are redirected this way, malloc keeps going to glibc.
+
+#include "redirect_core.hpp"
+
+#include <cstddef>
+#include <new>
+
+namespace {
+void *allocate_or_throw(const std::size_t size, const std::size_t align) {
+  for (;;) {
+    if (void *p = redirect::allocate(size, align)) {
+      return p;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+} // namespace
+
+void *operator new(std::size_t size) {
+  return allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size) {
+  return allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  return allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+  return allocate_or_throw(size, static_cast<std::size_t>(align));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return redirect::allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return redirect::allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+  return redirect::allocate(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+  return redirect::allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *p) noexcept { redirect::release(p); }
+
+void operator delete[](void *p) noexcept { redirect::release(p); }
+
+void operator delete(void *p, std::size_t) noexcept { redirect::release(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { redirect::release(p); }
+
+void operator delete(void *p, std::align_val_t) noexcept {
+  redirect::release(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+  redirect::release(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  redirect::release(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+  redirect::release(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  redirect::release(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  redirect::release(p);
+}
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept {
+  redirect::release(p);
+}
+
+void operator delete[](void *p, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  redirect::release(p);
+}
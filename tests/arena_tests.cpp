@@ -3,7 +3,10 @@
 
 #include "vortexalloc/allocator.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <thread>
 #include <vector>
 
 // Helper struct to track construction and destruction
@@ -95,4 +98,191 @@ TEST_CASE("reset reuses the current chunk", "[ChunkAllocator]") {
 
   // After reset the allocator should hand out the same address again
   REQUIRE(first == second);
-}
\ No newline at end of file
+}
+
+using CountingArena =
+    BasicArena<DoublingGrowth<>, NewBacking, SingleThreaded, CountingStats>;
+
+TEST_CASE("Fixed-size allocation respects alignment", "[BasicArena]") {
+  Arena arena;
+  (void)arena.allocate<1, 1>();
+  void *p = arena.allocate<24, 8>();
+  void *q = arena.allocate<64, 64>();
+  REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 8 == 0);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(q) % 64 == 0);
+}
+
+TEST_CASE("Byte-aligned fixed allocations are packed", "[BasicArena]") {
+  Arena arena;
+  auto *a = static_cast<std::byte *>(arena.allocate<3, 1>());
+  auto *b = static_cast<std::byte *>(arena.allocate<5, 1>());
+  REQUIRE(b == a + 3);
+}
+
+TEST_CASE("Stats policy counts requests and chunks", "[BasicArena]") {
+  CountingArena arena(1024);
+  for (int i = 0; i < 100; ++i) {
+    (void)arena.allocate(100, 8);
+  }
+  arena.reset();
+
+  const CountingStats &stats = arena.stats();
+  REQUIRE(stats.allocations == 100);
+  REQUIRE(stats.bytes_requested == 100 * 100);
+  REQUIRE(stats.bytes_reserved >= stats.bytes_requested);
+  REQUIRE(stats.resets == 1);
+
+  std::size_t chunks = 0;
+  for (const Chunk *c = arena.head_; c; c = c->next) {
+    ++chunks;
+  }
+  REQUIRE(stats.chunks == chunks);
+}
+
+TEST_CASE("Growing after reset keeps every chunk", "[BasicArena]") {
+  CountingArena arena(1024);
+  for (int i = 0; i < 10; ++i) {
+    (void)arena.allocate(1000, 8);
+  }
+  arena.reset();
+  (void)arena.allocate(512 * 1024, 8);
+
+  std::size_t chunks = 0;
+  for (const Chunk *c = arena.head_; c; c = c->next) {
+    ++chunks;
+  }
+  REQUIRE(chunks == arena.stats().chunks);
+}
+
+TEST_CASE("contains reports pointers into any chunk", "[BasicArena]") {
+  Arena arena(256);
+  void *first = arena.allocate(64, 8);
+  void *second = arena.allocate(1024, 8); // lands in a second chunk
+  int outside = 0;
+  REQUIRE(arena.head_->next != nullptr);
+  REQUIRE(arena.contains(first));
+  REQUIRE(arena.contains(second));
+  REQUIRE_FALSE(arena.contains(&outside));
+}
+
+TEST_CASE("Fixed growth keeps chunks at the initial size", "[BasicArena]") {
+  BasicArena<FixedGrowth> arena(4096);
+  for (int i = 0; i < 16; ++i) {
+    (void)arena.allocate(4000, 8);
+  }
+  for (const Chunk *c = arena.head_; c; c = c->next) {
+    REQUIRE(c->capacity == 4096);
+  }
+
+  // an oversized request gets its own chunk, the next ones are back to the
+  // initial size
+  (void)arena.allocate(100000, 8);
+  for (int i = 0; i < 40; ++i) {
+    (void)arena.allocate(4000, 8);
+  }
+  std::size_t oversized = 0;
+  for (const Chunk *c = arena.head_; c; c = c->next) {
+    if (c->capacity == 100000) {
+      ++oversized;
+    } else {
+      REQUIRE(c->capacity == 4096);
+    }
+  }
+  REQUIRE(oversized == 1);
+}
+
+TEST_CASE("Aligned backing starts chunks on the requested boundary",
+          "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, AlignedNewBacking<64>> arena(1000);
+  (void)arena.allocate(8, 8);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(arena.head_->memory) % 64 == 0);
+}
+
+TEST_CASE("Mutex-locked arena can be shared between threads",
+          "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, NewBacking, MutexLocked, CountingStats> arena;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&arena] {
+      for (int i = 0; i < 1000; ++i) {
+        *static_cast<int *>(arena.allocate<sizeof(int), alignof(int)>()) = i;
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  REQUIRE(arena.stats().allocations == 4000);
+}
+
+TEST_CASE("ChunkAllocator works over a custom arena", "[ChunkAllocator]") {
+  ChunkAllocator<int, CountingArena> alloc;
+  std::vector<int, ChunkAllocator<int, CountingArena>> vec{alloc};
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+  }
+  REQUIRE(vec.back() == 999);
+
+  using Rebound = std::allocator_traits<
+      ChunkAllocator<int, CountingArena>>::rebind_alloc<double>;
+  Rebound rebound(alloc);
+  REQUIRE(rebound.allocate(4) != nullptr);
+}
+
+namespace {
+bool all_zero(const void *p, const std::size_t bytes) {
+  const auto *b = static_cast<const unsigned char *>(p);
+  return std::all_of(b, b + bytes, [](unsigned char c) { return c == 0; });
+}
+} // namespace
+
+TEST_CASE("allocate_zeroed clears reused memory after reset", "[BasicArena]") {
+  Arena arena(4096);
+  std::memset(arena.allocate(1000, 8), 0xAB, 1000);
+  arena.reset();
+  void *p = arena.allocate_zeroed(2000, 8);
+  REQUIRE(all_zero(p, 2000));
+}
+
+TEST_CASE("allocate_zeroed clears past a plain allocation", "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, MmapBacking<>> arena(4096);
+  auto *plain = static_cast<unsigned char *>(arena.allocate(100, 8));
+  std::memset(plain, 0xAB, 100);
+  void *zeroed = arena.allocate_zeroed(1000, 8);
+  REQUIRE(all_zero(zeroed, 1000));
+  REQUIRE(plain[99] == 0xAB);
+}
+
+TEST_CASE("Zeroed backing tracks the dirty mark across resets",
+          "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, MmapBacking<>> arena(64 * 1024);
+  void *fresh = arena.allocate_zeroed(512, 8);
+  REQUIRE(all_zero(fresh, 512));
+  REQUIRE(arena.head_->dirty == 0);
+
+  std::memset(arena.allocate(3000, 8), 0xCD, 3000);
+  arena.reset();
+  REQUIRE(arena.head_->dirty == 3512);
+
+  void *reused = arena.allocate_zeroed(8000, 8);
+  REQUIRE(all_zero(reused, 8000));
+}
+
+TEST_CASE("Decommit reset hands dirty pages back to the OS", "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, MmapBacking<4096>> arena(256 * 1024);
+  std::memset(arena.allocate(100 * 1024, 8), 0xEF, 100 * 1024);
+
+  arena.reset(ResetMode::Decommit);
+  REQUIRE(arena.head_->dirty == 0);
+  REQUIRE(all_zero(arena.allocate_zeroed(100 * 1024, 8), 100 * 1024));
+}
+
+TEST_CASE("Decommit below the threshold falls back to memset",
+          "[BasicArena]") {
+  BasicArena<DoublingGrowth<>, MmapBacking<>> arena(256 * 1024);
+  std::memset(arena.allocate(1024, 8), 0xEF, 1024);
+
+  arena.reset(ResetMode::Decommit);
+  REQUIRE(arena.head_->dirty == 1024);
+  REQUIRE(all_zero(arena.allocate_zeroed(1024, 8), 1024));
+}
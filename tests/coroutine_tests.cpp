@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "vortexalloc/coroutine.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+// Minimal lazily started task that resumes its awaiter on completion
+template <typename FramePolicy> class Task {
+public:
+  struct promise_type : FramePolicy {
+    int value = 0;
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+
+    Task get_return_object() {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+        return h.promise().continuation;
+      }
+      void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void return_value(int v) { value = v; }
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  explicit Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+    handle_.promise().continuation = c;
+    return handle_;
+  }
+  int await_resume() noexcept { return handle_.promise().value; }
+
+  int run() {
+    handle_.resume();
+    return handle_.promise().value;
+  }
+
+  void *frame() const noexcept { return handle_.address(); }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+using ArenaTask = Task<ArenaFramePromise>;
+
+ArenaTask chain(FrameArena &frames, int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return 1 + co_await chain(frames, depth - 1);
+}
+
+ArenaTask heap_chain(int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return 1 + co_await heap_chain(depth - 1);
+}
+
+struct Service {
+  int base = 100;
+  ArenaTask handle(FrameArena &, int x) { co_return base + x; }
+};
+
+struct Request {
+  int id = 7;
+};
+
+// a free coroutine may take a class argument before the FrameArena too
+ArenaTask serve(Request &request, FrameArena &) { co_return request.id; }
+
+using SharedTask = Task<BasicArenaFramePromise<SharedFrameArena>>;
+
+SharedTask shared_chain(SharedFrameArena &frames, int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return 1 + co_await shared_chain(frames, depth - 1);
+}
+
+// the buffer lives across the suspension point, so it is part of the frame
+ArenaTask large_frame(FrameArena &frames) {
+  volatile char buffer[8192];
+  buffer[0] = 1;
+  buffer[sizeof(buffer) - 1] = 2;
+  const int inner = co_await chain(frames, 1);
+  co_return inner + buffer[0] + buffer[sizeof(buffer) - 1];
+}
+} // namespace
+
+TEST_CASE("Coroutine frames are placed in the FrameArena", "[FrameArena]") {
+  FrameArena frames;
+  ArenaTask task = chain(frames, 10);
+  REQUIRE(frames.arena().contains(task.frame()));
+  REQUIRE(task.run() == 10);
+}
+
+TEST_CASE("Member coroutines find the FrameArena after the object",
+          "[FrameArena]") {
+  FrameArena frames;
+  Service service;
+  ArenaTask task = service.handle(frames, 5);
+  REQUIRE(frames.arena().contains(task.frame()));
+  REQUIRE(task.run() == 105);
+}
+
+TEST_CASE("Free coroutines find the FrameArena after a class argument",
+          "[FrameArena]") {
+  FrameArena frames;
+  Request request;
+  ArenaTask task = serve(request, frames);
+  REQUIRE(frames.arena().contains(task.frame()));
+  REQUIRE(task.run() == 7);
+}
+
+TEST_CASE("Frames of the same shape are recycled", "[FrameArena]") {
+  FrameArena frames;
+  REQUIRE(chain(frames, 256).run() == 256);
+
+  const Chunk *chunk = frames.arena().current_;
+  const std::size_t offset = chunk->offset;
+
+  // the second run must be served entirely from the free lists
+  REQUIRE(chain(frames, 256).run() == 256);
+  REQUIRE(frames.arena().current_ == chunk);
+  REQUIRE(chunk->offset == offset);
+}
+
+TEST_CASE("Frames too large for a bucket go to the heap", "[FrameArena]") {
+  FrameArena frames;
+  REQUIRE(chain(frames, 1).run() == 1);
+  const Chunk *chunk = frames.arena().current_;
+  const std::size_t offset = chunk->offset;
+
+  for (int i = 0; i < 100; ++i) {
+    ArenaTask task = large_frame(frames);
+    REQUIRE_FALSE(frames.arena().contains(task.frame()));
+    REQUIRE(task.run() == 4);
+  }
+
+  // small frames came from the free lists, large ones never touched the arena
+  REQUIRE(frames.arena().current_ == chunk);
+  REQUIRE(chunk->offset == offset);
+}
+
+TEST_CASE("Frames without a FrameArena fall back to the heap",
+          "[FrameArena]") {
+  ArenaTask task = heap_chain(32);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(task.frame()) %
+              FrameArena::frame_align ==
+          0);
+  REQUIRE(task.run() == 32);
+}
+
+TEST_CASE("Shared frames can be resumed and destroyed on other threads",
+          "[FrameArena]") {
+  SharedFrameArena frames;
+  // Catch2 assertions are not thread safe, the workers only count
+  std::atomic<int> wrong_results{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&frames, &wrong_results] {
+      for (int i = 0; i < 200; ++i) {
+        // created here, run on another thread that also destroys the
+        // inner frames
+        SharedTask task = shared_chain(frames, 8);
+        std::thread([&task, &wrong_results] {
+          if (task.run() != 8) {
+            ++wrong_results;
+          }
+        }).join();
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  REQUIRE(wrong_results == 0);
+  REQUIRE(frames.arena().head_ != nullptr);
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "vortexalloc/object_pool.hpp"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace {
+struct PoolTracer {
+  static int ctor_count;
+  static int dtor_count;
+  int value;
+  explicit PoolTracer(int v) : value(v) { ++ctor_count; }
+  ~PoolTracer() { ++dtor_count; }
+};
+int PoolTracer::ctor_count = 0;
+int PoolTracer::dtor_count = 0;
+} // namespace
+
+TEST_CASE("create returns distinct aligned objects", "[ObjectPool]") {
+  struct alignas(32) Aligned32 {
+    std::uint64_t data[4]{};
+  };
+
+  ObjectPool<Aligned32> pool;
+  std::set<Aligned32 *> seen;
+  for (int i = 0; i < 1000; ++i) {
+    Aligned32 *p = pool.create();
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignof(Aligned32) == 0);
+    REQUIRE(seen.insert(p).second);
+  }
+  REQUIRE(pool.size() == 1000);
+}
+
+TEST_CASE("destroy makes the slot available for prompt reuse",
+          "[ObjectPool]") {
+  ObjectPool<int> pool;
+  int *a = pool.create(1);
+  int *b = pool.create(2);
+  pool.destroy(a);
+  REQUIRE(pool.size() == 1);
+
+  int *c = pool.create(3);
+  REQUIRE(c == a);
+  REQUIRE(*b == 2);
+  REQUIRE(*c == 3);
+}
+
+TEST_CASE("for_each_live visits exactly the live objects", "[ObjectPool]") {
+  ObjectPool<int> pool;
+  const int N = static_cast<int>(ObjectPool<int>::slots_per_slab) * 3 + 17;
+
+  std::vector<int *> ptrs;
+  for (int i = 0; i < N; ++i) {
+    ptrs.push_back(pool.create(i));
+  }
+  for (int i = 0; i < N; i += 2) {
+    pool.destroy(ptrs[i]);
+  }
+
+  std::multiset<int> visited;
+  pool.for_each_live([&](int &v) { visited.insert(v); });
+
+  REQUIRE(visited.size() == pool.size());
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(visited.count(i) == static_cast<std::size_t>(i % 2));
+  }
+}
+
+TEST_CASE("empty slabs are skipped by for_each_live", "[ObjectPool]") {
+  ObjectPool<int> pool;
+  std::vector<int *> ptrs;
+  for (std::size_t i = 0; i < ObjectPool<int>::slots_per_slab * 2; ++i) {
+    ptrs.push_back(pool.create(static_cast<int>(i)));
+  }
+  for (int *p : ptrs) {
+    pool.destroy(p);
+  }
+
+  std::size_t visits = 0;
+  pool.for_each_live([&](int &) { ++visits; });
+  REQUIRE(visits == 0);
+  REQUIRE(pool.empty());
+}
+
+TEST_CASE("pool destroys live objects on destruction and clear",
+          "[ObjectPool]") {
+  PoolTracer::ctor_count = 0;
+  PoolTracer::dtor_count = 0;
+
+  {
+    ObjectPool<PoolTracer> pool;
+    PoolTracer *first = pool.create(0);
+    for (int i = 1; i < 64; ++i) {
+      (void)pool.create(i);
+    }
+    pool.destroy(first);
+    REQUIRE(PoolTracer::dtor_count == 1);
+
+    pool.clear();
+    REQUIRE(PoolTracer::dtor_count == 64);
+    REQUIRE(pool.empty());
+
+    for (int i = 0; i < 10; ++i) {
+      (void)pool.create(i);
+    }
+  }
+
+  REQUIRE(PoolTracer::ctor_count == 74);
+  REQUIRE(PoolTracer::ctor_count == PoolTracer::dtor_count);
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "vortexalloc/redirect.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Linked against the vortexalloc_redirect_new objects, which replace the
+// global operator new/delete of this executable. Assertions stay outside of
+// the redirect scopes so that Catch2's own allocations never end up in an
+// arena that goes away.
+
+namespace {
+struct alignas(256) OverAligned {
+  int value = 0;
+};
+} // namespace
+
+TEST_CASE("The linked override is found without LD_PRELOAD", "[RedirectNew]") {
+  REQUIRE(ScopedArenaRedirect::available());
+}
+
+TEST_CASE("new inside a guard lands in the arena", "[RedirectNew]") {
+  Arena arena;
+  int *single;
+  int *array;
+  OverAligned *aligned;
+  void *c_block;
+  {
+    ScopedArenaRedirect redirect(arena);
+    single = new int(42);
+    array = new int[100];
+    aligned = new OverAligned;
+    c_block = std::malloc(64);
+  }
+  int *outside = new int(7);
+
+  REQUIRE(arena.contains(single));
+  REQUIRE(arena.contains(array));
+  REQUIRE(arena.contains(aligned));
+  REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % alignof(OverAligned) ==
+          0);
+  // only C++ allocations are redirected by the override
+  REQUIRE_FALSE(arena.contains(c_block));
+  REQUIRE_FALSE(arena.contains(outside));
+
+  delete single;
+  delete[] array;
+  delete aligned;
+  delete outside;
+  std::free(c_block);
+}
+
+TEST_CASE("delete of arena memory is a no-op", "[RedirectNew]") {
+  Arena arena;
+  int *first;
+  int *second;
+  std::size_t offset_before_delete;
+  std::size_t offset_after_delete;
+  {
+    ScopedArenaRedirect redirect(arena);
+    first = new int(1);
+    offset_before_delete = arena.current_->offset;
+    delete first;
+    offset_after_delete = arena.current_->offset;
+    // nothing was handed back, so the next block is a fresh one
+    second = new int(2);
+  }
+
+  REQUIRE(offset_before_delete == offset_after_delete);
+  REQUIRE(second != first);
+  REQUIRE(arena.contains(second));
+}
+
+TEST_CASE("Standard containers allocate from the arena", "[RedirectNew]") {
+  Arena arena;
+  std::vector<std::string> *lines;
+  const char *string_data;
+  {
+    ScopedArenaRedirect redirect(arena);
+    lines = new std::vector<std::string>;
+    for (int i = 0; i < 1000; ++i) {
+      lines->push_back("some string that does not fit SSO " +
+                       std::to_string(i));
+    }
+    string_data = lines->back().data();
+  }
+
+  REQUIRE(arena.contains(lines));
+  REQUIRE(arena.contains(string_data));
+  REQUIRE(lines->size() == 1000);
+
+  // the arena memory stays valid until the arena goes, delete is a no-op
+  delete lines;
+}
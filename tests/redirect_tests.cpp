@@ -0,0 +1,212 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "vortexalloc/redirect.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Run with the shim preloaded, e.g.
+//   LD_PRELOAD=libvortexalloc_preload.so ./redirect_tests
+// Assertions stay outside of the redirect scopes so that Catch2's own
+// allocations never end up in an arena that goes away.
+
+TEST_CASE("malloc is routed into the active arena", "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  Arena arena;
+  bool inside_from_arena;
+  void *outside;
+  std::size_t offset_before_free;
+  std::size_t offset_after_free;
+  {
+    ScopedArenaRedirect redirect(arena);
+    void *inside = std::malloc(100);
+    // checked before free() so the pointer is never used after it
+    inside_from_arena = arena.contains(inside);
+    offset_before_free = arena.current_->offset;
+    std::free(inside);
+    offset_after_free = arena.current_->offset;
+  }
+  outside = std::malloc(100);
+
+  REQUIRE(inside_from_arena);
+  REQUIRE_FALSE(arena.contains(outside));
+  REQUIRE(offset_before_free == offset_after_free);
+  std::free(outside);
+}
+
+TEST_CASE("Nested guards restore the outer arena", "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  Arena outer;
+  Arena inner;
+  void *a;
+  void *b;
+  void *c;
+  {
+    ScopedArenaRedirect outer_redirect(outer);
+    a = std::malloc(32);
+    {
+      ScopedArenaRedirect inner_redirect(inner);
+      b = std::malloc(32);
+    }
+    c = std::malloc(32);
+  }
+
+  REQUIRE(outer.contains(a));
+  REQUIRE(inner.contains(b));
+  REQUIRE(outer.contains(c));
+}
+
+TEST_CASE("realloc and aligned requests from the arena", "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  Arena arena;
+  char *grown;
+  void *aligned = nullptr;
+  int rc;
+  {
+    ScopedArenaRedirect redirect(arena);
+    auto *p = static_cast<char *>(std::malloc(16));
+    std::memcpy(p, "vortexalloc", 12);
+    grown = static_cast<char *>(std::realloc(p, 4096));
+    rc = posix_memalign(&aligned, 256, 100);
+  }
+
+  REQUIRE(arena.contains(grown));
+  REQUIRE(std::strcmp(grown, "vortexalloc") == 0);
+  REQUIRE(rc == 0);
+  REQUIRE(arena.contains(aligned));
+  REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 256 == 0);
+}
+
+TEST_CASE("Unmodified library code allocates from the arena", "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  Arena arena;
+  bool duplicate_from_arena;
+  char *stream_buffer = nullptr;
+  std::size_t stream_size = 0;
+  const char *string_data;
+  std::size_t string_size;
+  {
+    ScopedArenaRedirect redirect(arena);
+
+    // glibc internals
+    char *duplicate = strdup("request payload");
+    duplicate_from_arena = arena.contains(duplicate);
+    FILE *stream = open_memstream(&stream_buffer, &stream_size);
+    for (int i = 0; i < 10'000; ++i) {
+      std::fprintf(stream, "line %d\n", i);
+    }
+    std::fclose(stream);
+
+    // libstdc++ containers through the default operator new
+    std::vector<std::string> lines;
+    for (int i = 0; i < 1000; ++i) {
+      lines.push_back("some string that does not fit SSO " +
+                      std::to_string(i));
+    }
+    std::string *last = new std::string(lines.back());
+    string_data = last->data();
+    string_size = last->size();
+    delete last;
+
+    std::free(duplicate);
+    std::free(stream_buffer);
+  }
+
+  REQUIRE(duplicate_from_arena);
+  REQUIRE(arena.contains(stream_buffer));
+  REQUIRE(stream_size > 10'000);
+  REQUIRE(std::strncmp(stream_buffer, "line 0\n", 7) == 0);
+  REQUIRE(arena.contains(string_data));
+  REQUIRE(string_size > 0);
+}
+
+TEST_CASE("Arena pointers freed after the guard are still ignored",
+          "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  auto *arena = new Arena(4096);
+  std::vector<void *> blocks;
+  blocks.reserve(1000); // the vector itself must not live in the arena
+  {
+    ScopedArenaRedirect redirect(*arena);
+    for (int i = 0; i < 1000; ++i) {
+      blocks.push_back(std::malloc(64));
+    }
+  }
+
+  for (void *p : blocks) {
+    std::free(p);
+  }
+  delete arena;
+
+  // the arena's chunks went back to glibc and can be reused normally
+  std::vector<void *> fresh;
+  for (int i = 0; i < 1000; ++i) {
+    fresh.push_back(std::malloc(64));
+  }
+  for (void *p : fresh) {
+    std::free(p);
+  }
+  REQUIRE(fresh.size() == 1000);
+}
+
+TEST_CASE("Chunks past the registry limit fall back to glibc", "[Redirect]") {
+  if (!ScopedArenaRedirect::available()) {
+    SKIP("redirection shim is not loaded");
+  }
+
+  // more live chunks than the shim can track, one per arena
+  constexpr int kArenas = 5000;
+  std::vector<std::unique_ptr<Arena>> arenas;
+  std::vector<void *> blocks;
+  arenas.reserve(kArenas);
+  blocks.reserve(kArenas);
+  for (int i = 0; i < kArenas; ++i) {
+    arenas.push_back(std::make_unique<Arena>(4096));
+  }
+  for (int i = 0; i < kArenas; ++i) {
+    ScopedArenaRedirect redirect(*arenas[i]);
+    blocks.push_back(std::malloc(64));
+  }
+
+  int from_arena = 0;
+  for (int i = 0; i < kArenas; ++i) {
+    from_arena += arenas[i]->contains(blocks[i]) ? 1 : 0;
+  }
+
+  // glibc must get back exactly the blocks it handed out
+  for (void *p : blocks) {
+    std::free(p);
+  }
+  arenas.clear();
+
+  REQUIRE(from_arena > 0);
+  REQUIRE(from_arena < kArenas);
+
+  // the registry has room again once the arenas are gone
+  Arena arena;
+  void *p;
+  {
+    ScopedArenaRedirect redirect(arena);
+    p = std::malloc(64);
+  }
+  REQUIRE(arena.contains(p));
+}
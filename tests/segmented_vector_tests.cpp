@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "vortexalloc/segmented_vector.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+using CountingArena =
+    BasicArena<DoublingGrowth<>, NewBacking, SingleThreaded, CountingStats>;
+
+struct SegTracer {
+  static int live;
+  int value;
+  explicit SegTracer(int v) : value(v) { ++live; }
+  SegTracer(const SegTracer &other) : value(other.value) { ++live; }
+  ~SegTracer() { --live; }
+};
+int SegTracer::live = 0;
+} // namespace
+
+TEST_CASE("push_back and indexing across segments", "[SegmentedVector]") {
+  SegmentedVector<int> vec;
+  const int N = 100'000;
+  for (int i = 0; i < N; ++i) {
+    vec.push_back(i);
+  }
+
+  REQUIRE(vec.size() == static_cast<std::size_t>(N));
+  REQUIRE(vec.capacity() >= vec.size());
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(vec[i] == i);
+  }
+  REQUIRE(vec.front() == 0);
+  REQUIRE(vec.back() == N - 1);
+  REQUIRE_THROWS_AS(vec.at(N), std::out_of_range);
+}
+
+TEST_CASE("Element addresses are stable while growing", "[SegmentedVector]") {
+  SegmentedVector<std::string> vec;
+  vec.emplace_back("first");
+  const std::string *first = &vec[0];
+
+  std::vector<const std::string *> addresses;
+  for (int i = 0; i < 10'000; ++i) {
+    addresses.push_back(&vec.emplace_back(std::to_string(i)));
+  }
+
+  REQUIRE(&vec[0] == first);
+  REQUIRE(*first == "first");
+  for (int i = 0; i < 10'000; ++i) {
+    REQUIRE(&vec[i + 1] == addresses[i]);
+  }
+}
+
+TEST_CASE("Growth leaves no dead buffers in the arena", "[SegmentedVector]") {
+  ChunkAllocator<int, CountingArena> alloc;
+  {
+    SegmentedVector<int, ChunkAllocator<int, CountingArena>> vec(alloc);
+    for (int i = 0; i < 50'000; ++i) {
+      vec.push_back(i);
+    }
+    REQUIRE(alloc.arena()->stats().bytes_released == 0);
+    REQUIRE(alloc.arena()->stats().bytes_requested ==
+            vec.capacity() * sizeof(int));
+  }
+}
+
+TEST_CASE("Segment-wise iteration covers every element in order",
+          "[SegmentedVector]") {
+  SegmentedVector<int> vec;
+  const int N = 5000;
+  for (int i = 0; i < N; ++i) {
+    vec.push_back(i);
+  }
+
+  int expected = 0;
+  std::size_t segments = 0;
+  vec.for_each_segment([&](const int *data, std::size_t count) {
+    ++segments;
+    for (std::size_t i = 0; i < count; ++i) {
+      REQUIRE(data[i] == expected++);
+    }
+  });
+  REQUIRE(expected == N);
+  REQUIRE(segments == vec.segment_count());
+}
+
+TEST_CASE("Iterators work with standard algorithms", "[SegmentedVector]") {
+  SegmentedVector<int> vec;
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(999 - i);
+  }
+
+  std::sort(vec.begin(), vec.end());
+  REQUIRE(std::is_sorted(vec.cbegin(), vec.cend()));
+  REQUIRE(std::accumulate(vec.begin(), vec.end(), 0) == 999 * 1000 / 2);
+  REQUIRE(vec.end() - vec.begin() == 1000);
+  REQUIRE(vec.begin()[500] == 500);
+}
+
+TEST_CASE("pop_back, clear and destruction destroy elements",
+          "[SegmentedVector]") {
+  SegTracer::live = 0;
+  {
+    SegmentedVector<SegTracer> vec;
+    for (int i = 0; i < 300; ++i) {
+      vec.emplace_back(i);
+    }
+    const std::size_t capacity = vec.capacity();
+
+    // pop across a segment boundary
+    while (vec.size() > SegmentedVector<SegTracer>::first_segment - 1) {
+      vec.pop_back();
+    }
+    REQUIRE(SegTracer::live == static_cast<int>(vec.size()));
+    REQUIRE(vec.back().value == static_cast<int>(vec.size()) - 1);
+
+    vec.emplace_back(-1);
+    REQUIRE(vec.back().value == -1);
+
+    vec.clear();
+    REQUIRE(SegTracer::live == 0);
+    REQUIRE(vec.capacity() == capacity);
+
+    for (int i = 0; i < 100; ++i) {
+      vec.emplace_back(i);
+    }
+  }
+  REQUIRE(SegTracer::live == 0);
+}
+
+TEST_CASE("Works with std::allocator", "[SegmentedVector]") {
+  SegmentedVector<int, std::allocator<int>> vec;
+  for (int i = 0; i < 10'000; ++i) {
+    vec.push_back(i);
+  }
+  SegmentedVector<int, std::allocator<int>> moved(std::move(vec));
+  REQUIRE(vec.empty());
+  REQUIRE(moved.size() == 10'000);
+  REQUIRE(moved[9'999] == 9'999);
+}